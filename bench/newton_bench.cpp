@@ -0,0 +1,998 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <numeric>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include <csv.hpp>
+#include <random.hpp>
+
+#include "Arena.h"
+#include "BigMaze.h"
+#include "Bot.h"
+#include "ChunkedMaze.h"
+#include "CompressedMaze.h"
+#include "DistanceField.h"
+#include "FieldOfView.h"
+#include "Game.h"
+#include "LevelCache.h"
+#include "LevelCatalog.h"
+#include "LevelPipeline.h"
+#include "Maze.h"
+#include "NextHopTable.h"
+#include "SplitMix64.h"
+#include "ThreadPool.h"
+#include "VectorEnv.h"
+#include "Zobrist.h"
+
+// Benchmark-uri pentru nucleul jocului. Fiecare benchmark ruleaza pentru fiecare dimensiune si fiecare seed,
+// iar rezultatele (mediana si percentilele timpilor per operatie) sunt scrise in CSV.
+//
+// Utilizare: newton_bench [--sizes 10,20,30] [--seeds N] [--reps N] [--out fisier.csv] [--threads N] [--pin]
+//                         [--layout-sizes 1000,4000,16000]
+
+namespace {
+
+using BenchClock = std::chrono::steady_clock;
+
+// streambuf care doar numara octetii scrisi; render() si destructorii scriu in std::cout
+class CountingBuffer : public std::streambuf {
+public:
+    [[nodiscard]] std::uint64_t count() const { return m_count.load(std::memory_order_relaxed); }
+    void reset() { m_count = 0; }
+
+protected:
+    int_type overflow(const int_type ch) override {
+        if (ch != traits_type::eof()) {
+            ++m_count;
+        }
+        return ch;
+    }
+
+    std::streamsize xsputn(const char *, const std::streamsize n) override {
+        m_count += (std::uint64_t) n;
+        return n;
+    }
+
+private:
+    std::atomic<std::uint64_t> m_count{0}; // si task-urile din pool (jocurile botilor) scriu pe std::cout
+};
+
+struct Options {
+    std::vector<int> sizes{10, 20, 30, 100, 300, 1000};
+    // benchmark-urile de layout; un labirint are size^2 octeti, dar MortonLayout rotunjeste latura la urmatoarea
+    // putere a lui 2 (50000 -> 2.5 GB rand cu rand, 65536^2 = 4.3 GB in ordinea Z)
+    std::vector<int> layoutSizes{1000};
+    int seeds = 5;
+    int reps = 20;
+    std::string out = "bench_results.csv";
+};
+
+// valoare in care benchmark-urile scriu rezultate ca apelurile masurate sa nu fie eliminate de compilator
+volatile std::uint64_t sink;
+
+double elapsedNs(const BenchClock::time_point start) {
+    return std::chrono::duration<double, std::nano>(BenchClock::now() - start).count();
+}
+
+double percentile(const std::vector<double> &sorted, const double p) { // nearest-rank
+    const auto rank = (std::size_t) std::ceil(p / 100.0 * (double) sorted.size());
+    return sorted[std::clamp<std::size_t>(rank, 1, sorted.size()) - 1];
+}
+
+class Report {
+public:
+    explicit Report(const std::string &path) : m_file(path), m_writer(csv::make_csv_writer(m_file)) {
+        m_writer << std::vector<std::string>{"benchmark", "maze_size", "samples", "mean_ns", "median_ns",
+                                             "p90_ns", "p99_ns", "min_ns", "max_ns", "bytes"};
+    }
+
+    // samples = timpi per operatie in ns; bytes = octeti produsi per operatie (0 daca nu are sens)
+    void add(const std::string &benchmark, const int size, std::vector<double> samples, const std::uint64_t bytes = 0) {
+        std::sort(samples.begin(), samples.end());
+        const double mean = std::accumulate(samples.begin(), samples.end(), 0.0) / (double) samples.size();
+
+        m_writer << std::vector<std::string>{benchmark, std::to_string(size), std::to_string(samples.size()),
+                                             format(mean), format(percentile(samples, 50)),
+                                             format(percentile(samples, 90)), format(percentile(samples, 99)),
+                                             format(samples.front()), format(samples.back()), std::to_string(bytes)};
+        std::cerr << benchmark << " size=" << size << " median=" << format(percentile(samples, 50)) << " ns" << std::endl;
+    }
+
+private:
+    static std::string format(const double value) {
+        std::ostringstream out;
+        out.precision(1);
+        out << std::fixed << value;
+        return out.str();
+    }
+
+    std::ofstream m_file;
+    csv::CSVWriter<std::ofstream> m_writer;
+};
+
+Maze generatedMaze(const int size) {
+    Maze maze{size};
+    maze.generate();
+    return maze;
+}
+
+void benchGenerate(Report &report, const Options &options, const int size) {
+    std::vector<double> samples;
+    for (int seed = 0; seed < options.seeds; seed++) {
+        effolkronium::random_static::seed((std::uint32_t) seed);
+        for (int rep = 0; rep < options.reps; rep++) {
+            Maze maze{size};
+            const auto start = BenchClock::now();
+            maze.generate();
+            samples.push_back(elapsedNs(start));
+        }
+    }
+    report.add("maze_generate", size, samples);
+}
+
+void benchFreeCells(Report &report, const Options &options, const int size) {
+    std::vector<double> samples;
+    for (int seed = 0; seed < options.seeds; seed++) {
+        effolkronium::random_static::seed((std::uint32_t) seed);
+        Maze maze = generatedMaze(size);
+        for (int rep = 0; rep < options.reps; rep++) {
+            const auto start = BenchClock::now();
+            sink = maze.getFreeCells().size();
+            samples.push_back(elapsedNs(start));
+        }
+    }
+    report.add("get_free_cells", size, samples);
+}
+
+void benchCreateHole(Report &report, const Options &options, const int size) {
+    constexpr int holesPerSample = 256; // un singur apel e prea scurt pentru rezolutia ceasului
+    std::vector<double> samples;
+    for (int seed = 0; seed < options.seeds; seed++) {
+        effolkronium::random_static::seed((std::uint32_t) seed);
+        const Maze original = generatedMaze(size);
+        for (int rep = 0; rep < options.reps; rep++) {
+            Maze maze = original;
+            std::vector<std::pair<int, int>> targets;
+            for (int i = 0; i < holesPerSample; i++) {
+                targets.emplace_back(effolkronium::random_static::get(0, size - 1), effolkronium::random_static::get(0, size - 1));
+            }
+
+            const auto start = BenchClock::now();
+            for (const auto &[row, col]: targets) {
+                maze.createHole(row, col);
+            }
+            samples.push_back(elapsedNs(start) / holesPerSample);
+        }
+    }
+    report.add("create_hole", size, samples);
+}
+
+void benchApplePlacement(Report &report, const Options &options, const int size) {
+    std::vector<double> samples;
+    for (int seed = 0; seed < options.seeds; seed++) {
+        effolkronium::random_static::seed((std::uint32_t) seed);
+        Maze maze = generatedMaze(size);
+        const std::vector<std::pair<int, int>> freeCells = maze.getFreeCells();
+        for (int rep = 0; rep < options.reps; rep++) {
+            const auto start = BenchClock::now();
+            sink = Game::placeApples(freeCells).size();
+            samples.push_back(elapsedNs(start));
+        }
+    }
+    report.add("apple_placement", size, samples);
+}
+
+// campul de distante pana la cel mai apropiat mar: culegerea merelor unul cate unul, actualizata incremental,
+// fata de un BFS complet din merele ramase dupa fiecare culegere
+void benchAppleField(Report &report, const Options &options, const int size) {
+    std::vector<double> incremental, full;
+    std::uint64_t touched = 0, cells = 0;
+    for (int seed = 0; seed < options.seeds; seed++) {
+        effolkronium::random_static::seed((std::uint32_t) seed);
+        Maze maze = generatedMaze(size);
+        std::vector<std::pair<int, int>> apples;
+        for (const Object &obj: Game::placeApples(maze.getFreeCells())) {
+            apples.push_back(obj.getPosition());
+        }
+
+        DistanceField field, rebuilt;
+        field.reset(maze, apples);
+        while (!apples.empty()) {
+            const auto [row, col] = apples.back();
+            apples.pop_back();
+
+            auto start = BenchClock::now();
+            field.removeSource(row, col);
+            incremental.push_back(elapsedNs(start));
+            touched += field.lastUpdateCells();
+
+            start = BenchClock::now();
+            rebuilt.reset(maze, apples);
+            full.push_back(elapsedNs(start));
+            cells += rebuilt.lastUpdateCells();
+            sink = (std::uint64_t) field.distance(0, 0) + (std::uint64_t) rebuilt.distance(0, 0);
+        }
+    }
+    std::cerr << "apple_field size=" << size << " incremental updates touch "
+              << (cells == 0 ? 0.0 : 100.0 * (double) touched / (double) cells) << "% of the cells of a full BFS" << std::endl;
+    report.add("apple_field_remove", size, incremental);
+    report.add("apple_field_reset", size, full);
+}
+
+// ceata de razboi: recalcularea campului vizual dupa fiecare pas al unui jucator care se plimba la intamplare, cu o
+// raza mica si cu una cat labirintul
+void benchFieldOfView(Report &report, const Options &options, const int size) {
+    constexpr int movesPerSeed = 4096;
+    constexpr int directions[4][2] = {{-1, 0}, {0, -1}, {1, 0}, {0, 1}};
+    std::vector<double> narrow, wide;
+    std::uint64_t visible = 0;
+    for (int seed = 0; seed < options.seeds; seed++) {
+        effolkronium::random_static::seed((std::uint32_t) seed);
+        Maze maze = generatedMaze(size);
+        SplitMix64 rng{(std::uint64_t) seed};
+        FieldOfView small, large;
+        small.reset(maze, 8, 0, 0);
+        large.reset(maze, size, 0, 0);
+
+        int row = 0, col = 0;
+        for (int move = 0; move < movesPerSeed; move++) {
+            const auto &direction = directions[uniformInt(rng, 0, 3)];
+            if (!maze.isPositionAvailable(row + direction[0], col + direction[1])) {
+                continue;
+            }
+            row += direction[0];
+            col += direction[1];
+
+            auto start = BenchClock::now();
+            small.moveTo(row, col);
+            narrow.push_back(elapsedNs(start));
+
+            start = BenchClock::now();
+            large.moveTo(row, col);
+            wide.push_back(elapsedNs(start));
+            visible += large.visibleCells().size();
+        }
+    }
+    std::cerr << "fov size=" << size << " sees " << (wide.empty() ? 0.0 : (double) visible / (double) wide.size())
+              << " cells per move with a radius of " << size << std::endl;
+    report.add("fov_move_r8", size, narrow);
+    report.add("fov_move_full", size, wide);
+}
+
+// tabela de rutare intre toate perechile: constructia pe thread pool si o interogare "in ce parte o iau spre X"
+// golden: pentru fiecare tinta din targets, un BFS scris separat de tabela; din orice celula libera direction() trebuie
+// sa faca un pas care scade distanta cu 1, iar None sa apara exact cand celula este tinta sau nu ajunge la ea
+bool checkNextHop(const Maze &maze, const NextHopTable &table, const std::vector<std::pair<int, int>> &targets) {
+    const int dim = maze.getSize();
+    const auto open = [&](const int row, const int col) {
+        return row >= 0 && col >= 0 && row < dim && col < dim && !maze.isWall(row, col);
+    };
+    std::vector<int> distance((std::size_t) dim * dim);
+    std::vector<std::pair<int, int>> frontier;
+    for (const auto &[toRow, toCol]: targets) {
+        std::fill(distance.begin(), distance.end(), -1);
+        distance[(std::size_t) toRow * dim + toCol] = 0;
+        frontier.assign(1, {toRow, toCol});
+        for (std::size_t head = 0; head < frontier.size(); head++) {
+            const auto [row, col] = frontier[head];
+            const std::pair<int, int> neighbours[4] = {{row - 1, col}, {row, col - 1}, {row + 1, col}, {row, col + 1}};
+            for (const auto &[nr, nc]: neighbours) {
+                if (open(nr, nc) && distance[(std::size_t) nr * dim + nc] < 0) {
+                    distance[(std::size_t) nr * dim + nc] = distance[(std::size_t) row * dim + col] + 1;
+                    frontier.emplace_back(nr, nc);
+                }
+            }
+        }
+
+        for (int row = 0; row < dim; row++) {
+            for (int col = 0; col < dim; col++) {
+                if (!open(row, col)) {
+                    continue;
+                }
+                const int here = distance[(std::size_t) row * dim + col];
+                const auto [nr, nc] = table.nextStep(row, col, toRow, toCol);
+                const bool none = table.direction(row, col, toRow, toCol) == NextHopTable::Direction::None;
+                const bool correct = here <= 0 ? none : !none && open(nr, nc) && distance[(std::size_t) nr * dim + nc] == here - 1;
+                if (!correct) {
+                    std::cerr << "Next hop from (" << row << ", " << col << ") to (" << toRow << ", " << toCol
+                              << ") disagrees with BFS" << std::endl;
+                    return false;
+                }
+            }
+        }
+    }
+    return true;
+}
+
+bool benchNextHop(Report &report, const Options &options, const int size) {
+    constexpr int queriesPerSample = 1024;
+    constexpr std::size_t botTargets = 16; // cam cate mere si iesirea are un bot
+    std::vector<double> build, lookup, targetsBuild;
+    std::size_t bytes = 0;
+    for (int seed = 0; seed < options.seeds; seed++) {
+        effolkronium::random_static::seed((std::uint32_t) seed);
+        Maze maze = generatedMaze(size);
+        const std::vector<std::pair<int, int>> freeCells = maze.getFreeCells();
+        if ((int) freeCells.size() > NextHopTable::maxCells) {
+            return true; // labirint prea mare pentru o tabela completa
+        }
+
+        NextHopTable table;
+        for (int rep = 0; rep < options.reps; rep++) {
+            const auto start = BenchClock::now();
+            table = NextHopTable{maze};
+            build.push_back(elapsedNs(start));
+        }
+        bytes = table.tableBytes();
+
+        // tabela doar pentru cateva tinte, ca la boti: iesirea si celule libere alese din seed
+        std::vector<std::pair<int, int>> targets{{0, 0}};
+        for (std::size_t i = 0; i < botTargets && i < freeCells.size(); i++) {
+            targets.push_back(freeCells[effolkronium::random_static::get<std::size_t>(0, freeCells.size() - 1)]);
+        }
+        NextHopTable partial;
+        for (int rep = 0; rep < options.reps; rep++) {
+            const auto start = BenchClock::now();
+            partial = NextHopTable{maze, targets};
+            targetsBuild.push_back(elapsedNs(start));
+        }
+
+        std::vector<std::pair<int, int>> allCells;
+        for (int row = 0; row < size; row++) {
+            for (int col = 0; col < size; col++) {
+                if (!maze.isWall(row, col)) {
+                    allCells.emplace_back(row, col);
+                }
+            }
+        }
+        if (!checkNextHop(maze, table, allCells) || !checkNextHop(maze, partial, targets)) {
+            return false;
+        }
+
+        for (int rep = 0; rep < options.reps; rep++) {
+            std::vector<std::pair<std::pair<int, int>, std::pair<int, int>>> queries;
+            for (int i = 0; i < queriesPerSample; i++) {
+                queries.emplace_back(freeCells[effolkronium::random_static::get<std::size_t>(0, freeCells.size() - 1)],
+                                     freeCells[effolkronium::random_static::get<std::size_t>(0, freeCells.size() - 1)]);
+            }
+
+            std::uint64_t steps = 0;
+            const auto start = BenchClock::now();
+            for (const auto &[from, to]: queries) {
+                steps += (std::uint64_t) table.direction(from.first, from.second, to.first, to.second);
+            }
+            lookup.push_back(elapsedNs(start) / queriesPerSample);
+            sink = steps;
+        }
+    }
+    report.add("next_hop_build", size, build, bytes);
+    report.add("next_hop_build_targets", size, targetsBuild);
+    report.add("next_hop_lookup", size, lookup);
+    return true;
+}
+
+// jocuri intregi jucate de boti (generarea nivelului inclusa); castigurile se afiseaza pe stderr
+void benchBots(Report &report, const Options &options, const int size) {
+    constexpr int gamesPerSample = 16;
+    for (const char *name: {"greedy", "route", "bomb"}) {
+        std::vector<double> samples;
+        int wins = 0, games = 0;
+        for (int seed = 0; seed < options.seeds; seed++) {
+            for (int rep = 0; rep < options.reps; rep++) {
+                const BotStats stats = runBotGames(name, size, gamesPerSample, (std::uint64_t) (seed * options.reps + rep));
+                samples.push_back(stats.seconds * 1e9 / stats.games);
+                wins += stats.wins;
+                games += stats.games;
+            }
+        }
+        std::cerr << "bot_game_" << name << " size=" << size << " win rate " << 100.0 * wins / games << "%" << std::endl;
+        report.add(std::string("bot_game_") + name, size, samples);
+    }
+}
+
+void benchHandleEvent(Report &report, const Options &options, const int size) {
+    constexpr int eventsPerSample = 1024;
+    constexpr char keys[] = {'w', 'a', 's', 'd', 'f', ' '};
+    std::vector<double> samples;
+    for (int seed = 0; seed < options.seeds; seed++) {
+        effolkronium::random_static::seed((std::uint32_t) seed);
+        std::vector<int> events;
+        for (int i = 0; i < eventsPerSample; i++) {
+            events.push_back(keys[effolkronium::random_static::get(0, (int) std::size(keys) - 1)]);
+        }
+
+        for (int rep = 0; rep < options.reps; rep++) {
+            Game game{size};
+            game.setRenderEnabled(false);
+            const Game::Clock::time_point now = Game::Clock::now();
+            game.start(now);
+
+            const auto start = BenchClock::now();
+            for (const int key: events) {
+                game.step(now, key);
+            }
+            samples.push_back(elapsedNs(start) / eventsPerSample);
+        }
+    }
+    report.add("handle_event", size, samples);
+}
+
+void benchRender(Report &report, const Options &options, const int size, CountingBuffer &output) {
+    std::vector<double> samples;
+    std::uint64_t bytes = 0;
+    for (int seed = 0; seed < options.seeds; seed++) {
+        effolkronium::random_static::seed((std::uint32_t) seed);
+        Game game{size};
+        game.setRenderEnabled(false);
+        game.start(Game::Clock::now());
+        game.setRenderEnabled(true);
+
+        for (int rep = 0; rep < options.reps; rep++) {
+            output.reset();
+            const auto start = BenchClock::now();
+            game.render();
+            samples.push_back(elapsedNs(start));
+            bytes = std::max(bytes, output.count());
+        }
+    }
+    report.add("render", size, samples, bytes);
+}
+
+void benchVectorEnv(Report &report, const Options &options, const int size) {
+    constexpr int envs = 4096;
+    constexpr int stepsPerSample = 16;
+    std::vector<double> samples;
+    for (int seed = 0; seed < options.seeds; seed++) {
+        VectorEnv env{envs, size, (std::uint64_t) seed};
+        SplitMix64 rng{(std::uint64_t) seed};
+        std::vector<std::uint8_t> actions(envs);
+
+        for (int rep = 0; rep < options.reps; rep++) {
+            for (std::uint8_t &action: actions) {
+                action = (std::uint8_t) (rng() % VectorEnv::Noop);
+            }
+
+            const auto start = BenchClock::now();
+            for (int i = 0; i < stepsPerSample; i++) {
+                sink = env.step(actions).done[0];
+            }
+            samples.push_back(elapsedNs(start) / (envs * stepsPerSample)); // ns per pas al unei singure instante
+        }
+    }
+    report.add("vector_env_step", size, samples);
+}
+
+void benchArenaTick(Report &report, const Options &options, const int size) {
+    constexpr int players = 128;
+    constexpr char keys[] = {'w', 'a', 's', 'd', 'f', ' '};
+    std::vector<double> samples;
+    for (int seed = 0; seed < options.seeds; seed++) {
+        auto arena = std::make_unique<Arena>(size, players, (std::uint64_t) seed);
+        SplitMix64 rng{(std::uint64_t) seed};
+
+        for (int rep = 0; rep < options.reps; rep++) {
+            if (arena->isFinished()) {
+                arena = std::make_unique<Arena>(size, players, (std::uint64_t) seed + rep);
+            }
+            for (int player = 0; player < players; player++) {
+                (void) arena->pushInput(player, keys[rng() % std::size(keys)]);
+            }
+
+            const auto start = BenchClock::now();
+            arena->tick();
+            samples.push_back(elapsedNs(start)); // ns per tick cu toti jucatorii activi
+        }
+    }
+    report.add("arena_tick_128", size, samples);
+}
+
+// golden: mesaje cu hash-ul corect, dar cu un jucator in afara labirintului (prin keyframe, printr-un pas sau printr-o
+// pozitie absoluta); decoderul trebuie sa le respinga, altfel un server ostil ar scrie in afara grilei la afisare
+bool checkStateDecoder() {
+    constexpr int dim = 10;
+    const auto stateAt = [](const int row, const int col) {
+        SyncState state;
+        state.dim = dim;
+        state.wall.assign((std::size_t) dim * dim, 0);
+        state.apple.assign((std::size_t) dim * dim, 0);
+        state.players.push_back(SyncState::PlayerState{row, col, false, 0});
+        state.hash = Zobrist::hash(state);
+        return state;
+    };
+    // primul mesaj al unui encoder nou este keyframe, al doilea delta
+    const auto decodes = [&](const SyncState &first, const SyncState *second, std::uint64_t &desyncs) {
+        DeltaEncoder encoder;
+        DeltaDecoder decoder;
+        std::vector<std::uint8_t> message;
+        (void) encoder.encode(first, message);
+        bool accepted = decoder.apply(message);
+        if (second != nullptr) {
+            message.clear();
+            (void) encoder.encode(*second, message);
+            accepted = decoder.apply(message);
+        }
+        desyncs = decoder.desyncs();
+        return accepted;
+    };
+
+    std::uint64_t desyncs = 0;
+    const SyncState corner = stateAt(0, 0), farCorner = stateAt(dim - 1, dim - 1);
+    const SyncState above = stateAt(-1, 0), right = stateAt(dim - 1, dim), far = stateAt(5, dim);
+    const bool valid = decodes(corner, &farCorner, desyncs);
+    const bool keyframe = decodes(stateAt(dim, 0), nullptr, desyncs);
+    const bool stepUp = decodes(corner, &above, desyncs);
+    const std::uint64_t stepDesyncs = desyncs;
+    const bool stepRight = decodes(farCorner, &right, desyncs);
+    const bool absolute = decodes(corner, &far, desyncs);
+    if (!valid || keyframe || stepUp || stepRight || absolute || stepDesyncs != 1) {
+        std::cerr << "DeltaDecoder accepted a player outside the maze" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+void benchStateDelta(Report &report, const Options &options, const int size) {
+    constexpr int players = 128;
+    constexpr char keys[] = {'w', 'a', 's', 'd', 'f', ' '};
+    std::vector<double> samples;
+    std::uint64_t bytes = 0;
+    for (int seed = 0; seed < options.seeds; seed++) {
+        Arena arena{size, players, (std::uint64_t) seed};
+        DeltaEncoder encoder;
+        SyncState state;
+        std::vector<std::uint8_t> message;
+        SplitMix64 rng{(std::uint64_t) seed};
+
+        for (int rep = 0; rep < options.reps && !arena.isFinished(); rep++) {
+            for (int player = 0; player < players; player++) {
+                (void) arena.pushInput(player, keys[rng() % std::size(keys)]);
+            }
+            arena.tick();
+
+            message.clear();
+            const auto start = BenchClock::now();
+            arena.syncState(state);
+            (void) encoder.encode(state, message);
+            samples.push_back(elapsedNs(start)); // ns per mesaj, captura starii inclusa
+            bytes += message.size();
+        }
+    }
+    report.add("state_delta_128", size, samples, bytes);
+}
+
+void benchStateHash(Report &report, const Options &options, const int size) {
+    constexpr int hashesPerSample = 64;
+    std::vector<double> samples;
+    for (int seed = 0; seed < options.seeds; seed++) {
+        Arena arena{size, 1, (std::uint64_t) seed};
+        SyncState state;
+        arena.syncState(state);
+
+        for (int rep = 0; rep < options.reps; rep++) {
+            const auto start = BenchClock::now();
+            for (int i = 0; i < hashesPerSample; i++) {
+                sink = Zobrist::hash(state); // recalculare completa; stateHash() e doar o citire
+            }
+            samples.push_back(elapsedNs(start) / hashesPerSample);
+        }
+    }
+    report.add("state_hash_full", size, samples);
+}
+
+void benchLevelGenerate(Report &report, const Options &options, const int size) {
+    std::vector<double> samples;
+    for (int seed = 0; seed < options.seeds; seed++) {
+        for (int rep = 0; rep < options.reps; rep++) {
+            const auto start = BenchClock::now();
+            // dimensiunile 10..30 trec prin FixedMaze, celelalte prin Maze
+            sink = (std::uint64_t) Level::generate(size, (std::uint64_t) seed * options.reps + rep).parLength;
+            samples.push_back(elapsedNs(start));
+        }
+    }
+    report.add("level_generate", size, samples);
+}
+
+void benchLevelCache(Report &report, const Options &options, const int size) {
+    const std::filesystem::path directory = std::filesystem::temp_directory_path() / "newton_bench_levels";
+    std::filesystem::remove_all(directory);
+
+    std::vector<double> generated, fromDisk, fromMemory;
+    {
+        LevelCache cache{directory};
+        for (int seed = 0; seed < options.seeds; seed++) {
+            for (int rep = 0; rep < options.reps; rep++) {
+                const std::uint64_t levelSeed = (std::uint64_t) seed * options.reps + rep;
+
+                auto start = BenchClock::now();
+                sink = (std::uint64_t) cache.get(size, levelSeed)->parLength; // generare, analiza si scriere pe disc
+                generated.push_back(elapsedNs(start));
+
+                cache.clearMemory();
+                start = BenchClock::now();
+                sink = (std::uint64_t) cache.get(size, levelSeed)->parLength;
+                fromDisk.push_back(elapsedNs(start));
+
+                start = BenchClock::now();
+                sink = (std::uint64_t) cache.get(size, levelSeed)->parLength;
+                fromMemory.push_back(elapsedNs(start));
+            }
+        }
+    }
+    std::filesystem::remove_all(directory);
+
+    report.add("level_generate_and_store", size, generated);
+    report.add("level_cache_disk", size, fromDisk);
+    report.add("level_cache_memory", size, fromMemory);
+}
+
+void benchLevelTransition(Report &report, const Options &options, const int size) {
+    constexpr std::size_t depth = 4;
+    std::vector<double> samples;
+    for (int seed = 0; seed < options.seeds; seed++) {
+        LevelPipeline pipeline{size, (std::uint64_t) seed, depth};
+        for (int rep = 0; rep < options.reps; rep++) {
+            while (pipeline.ready() < depth) { // ca in timpul unui nivel jucat: coada plina, doar predarea se masoara
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+
+            const auto start = BenchClock::now();
+            const PreparedLevel prepared = pipeline.next();
+            Game game{size};
+            game.setRenderEnabled(false);
+            game.start(Game::Clock::now(), *prepared.level, prepared.timeLimit);
+            samples.push_back(elapsedNs(start));
+        }
+    }
+    report.add("level_transition", size, samples);
+}
+
+// BFS, bombe si render pe acelasi labirint in fiecare layout; doar asezarea celulelor in memorie difera
+// BFS din (0, 0) doar prin isPositionAvailable si cellIndex, ca timpii diferitelor stocari sa difere numai prin
+// accesul la celule; distance si frontier se refolosesc intre apeluri. Intoarce durata in ns.
+template<typename AnyMaze>
+double timedBfs(AnyMaze &maze, std::vector<std::int32_t> &distance, std::vector<std::pair<int, int>> &frontier) {
+    const auto start = BenchClock::now();
+    std::fill(distance.begin(), distance.end(), -1);
+    frontier.clear();
+    distance[maze.cellIndex(0, 0)] = 0;
+    frontier.emplace_back(0, 0);
+    for (std::size_t head = 0; head < frontier.size(); head++) {
+        const auto [row, col] = frontier[head];
+        const std::int32_t next = distance[maze.cellIndex(row, col)] + 1;
+        const std::pair<int, int> neighbours[4] = {{row - 1, col}, {row, col - 1}, {row + 1, col}, {row, col + 1}};
+        for (const auto &[nr, nc]: neighbours) {
+            if (maze.isPositionAvailable(nr, nc) && distance[maze.cellIndex(nr, nc)] < 0) {
+                distance[maze.cellIndex(nr, nc)] = next;
+                frontier.emplace_back(nr, nc);
+            }
+        }
+    }
+    return elapsedNs(start);
+}
+
+template<typename Layout>
+void benchLayout(Report &report, const Options &options, const int size, CountingBuffer &output) {
+    constexpr int blastsPerSample = 4096;
+    const std::string suffix = std::string("_") + Layout::name;
+    std::vector<double> bfs, blasts, render;
+    std::uint64_t bytes = 0;
+
+    for (int seed = 0; seed < options.seeds; seed++) {
+        BasicMaze<Layout> maze{size};
+        maze.generate((std::uint64_t) seed);
+
+        std::vector<std::int32_t> distance(maze.cellCount());
+        std::vector<std::pair<int, int>> frontier;
+        frontier.reserve((std::size_t) size * size);
+        for (int rep = 0; rep < options.reps; rep++) {
+            bfs.push_back(timedBfs(maze, distance, frontier));
+        }
+
+        SplitMix64 rng{(std::uint64_t) seed};
+        for (int rep = 0; rep < options.reps; rep++) {
+            BasicMaze<Layout> blasted = maze;
+            const auto start = BenchClock::now();
+            for (int i = 0; i < blastsPerSample; i++) {
+                blasted.createHole(uniformInt(rng, 0, size - 1), uniformInt(rng, 0, size - 1));
+            }
+            blasts.push_back(elapsedNs(start) / blastsPerSample);
+            sink = blasted.getHash();
+        }
+
+        for (int rep = 0; rep < options.reps; rep++) {
+            output.reset();
+            const auto start = BenchClock::now();
+            std::cout << maze;
+            render.push_back(elapsedNs(start));
+            bytes = std::max(bytes, output.count());
+        }
+    }
+
+    report.add("layout_bfs" + suffix, size, bfs);
+    report.add("layout_blast" + suffix, size, blasts);
+    report.add("layout_render" + suffix, size, render, bytes);
+}
+
+// stocarea comprimata pe tile-uri: raportul fata de Maze (un octet pe celula) si costul accesului pentru cateva
+// dimensiuni de cache. In coloana bytes: datele comprimate la generare, memoria cache-ului la accese.
+void benchCompressed(Report &report, const Options &options, const int size) {
+    constexpr int accessesPerSample = 1 << 16;
+    constexpr std::size_t cacheSizes[] = {4, 64};
+    std::vector<double> generate;
+    std::size_t compressedBytes = 0;
+
+    for (const std::size_t cacheTiles: cacheSizes) {
+        const std::string suffix = "_cache" + std::to_string(cacheTiles);
+        const std::uint64_t cacheBytes = cacheTiles * CompressedMaze::tileSize * CompressedMaze::tileSize;
+        std::vector<double> sequential, random, bfs;
+
+        for (int seed = 0; seed < options.seeds; seed++) {
+            CompressedMaze maze{size, cacheTiles};
+            auto start = BenchClock::now();
+            maze.generate((std::uint64_t) seed);
+            if (cacheTiles == cacheSizes[0]) {
+                generate.push_back(elapsedNs(start));
+                compressedBytes = std::max(compressedBytes, maze.compressedBytes());
+            }
+
+            SplitMix64 rng{(std::uint64_t) seed};
+            int row = 0, col = 0;
+            for (int rep = 0; rep < options.reps; rep++) {
+                start = BenchClock::now();
+                for (int i = 0; i < accessesPerSample; i++) { // rand cu rand, ca la afisare
+                    sink = maze.isWall(row, col);
+                    if (++col == size) {
+                        col = 0;
+                        row = (row + 1) % size;
+                    }
+                }
+                sequential.push_back(elapsedNs(start) / accessesPerSample);
+
+                start = BenchClock::now();
+                for (int i = 0; i < accessesPerSample; i++) {
+                    sink = maze.isWall(uniformInt(rng, 0, size - 1), uniformInt(rng, 0, size - 1));
+                }
+                random.push_back(elapsedNs(start) / accessesPerSample);
+            }
+
+            // un singur BFS per seed: cu un cache mic, aproape fiecare pas decomprima un tile
+            std::vector<std::int32_t> distance(maze.cellCount());
+            std::vector<std::pair<int, int>> frontier;
+            bfs.push_back(timedBfs(maze, distance, frontier));
+        }
+
+        report.add("compressed_sequential" + suffix, size, sequential, cacheBytes);
+        report.add("compressed_random" + suffix, size, random, cacheBytes);
+        report.add("compressed_bfs" + suffix, size, bfs, cacheBytes);
+    }
+
+    report.add("compressed_generate", size, generate, compressedBytes);
+    std::cerr << "compressed size=" << size << " ratio=" << (double) size * size / (double) compressedBytes
+              << " vs Maze, " << (double) size * size / 8.0 / (double) compressedBytes << " vs 1 bit/cell" << std::endl;
+}
+
+// o plimbare lunga pe coridorul liber al primei linii: cost per pas (cu prefetch ca in EndlessGame) si memoria
+// ramasa la final, care nu trebuie sa depinda de distanta
+void benchChunkedWalk(Report &report, const Options &options) {
+    constexpr int stepsPerSample = 1 << 16;
+    const std::filesystem::path directory = std::filesystem::temp_directory_path() / "newton_bench_world";
+    std::vector<double> samples;
+    std::uint64_t bytes = 0;
+    for (int seed = 0; seed < options.seeds; seed++) {
+        ChunkedMaze world{(std::uint64_t) seed, directory, 64};
+        int col = 0;
+        for (int rep = 0; rep < options.reps; rep++) {
+            const auto start = BenchClock::now();
+            for (int i = 0; i < stepsPerSample; i++, col++) {
+                sink = world.isPositionAvailable(0, col + 1);
+                world.prefetch(0, col + 1, 1);
+            }
+            samples.push_back(elapsedNs(start) / stepsPerSample);
+        }
+        bytes = std::max<std::uint64_t>(bytes, world.residentChunks() * ChunkedMaze::chunkSize * ChunkedMaze::chunkSize);
+    }
+    std::filesystem::remove_all(directory);
+    report.add("chunked_walk_step", ChunkedMaze::chunkSize, samples, bytes);
+}
+
+// labirint out-of-core de 2000 x 2000 cu 1 MiB pentru benzi (cate 16 linii): timp per celula pentru generare si
+// pentru rezolvare, iar octetii sunt cei cititi si scrisi de rezolvare
+void benchBigMaze(Report &report, const Options &options) {
+    constexpr int size = 2000;
+    constexpr double cells = (double) size * size;
+    const std::filesystem::path directory = std::filesystem::temp_directory_path();
+    std::vector<double> generate, solve;
+    std::uint64_t bytes = 0;
+    for (int seed = 0; seed < options.seeds; seed++) {
+        auto start = BenchClock::now();
+        BigMaze::generate(directory / "newton_bench.maze", size, (std::uint64_t) seed);
+        generate.push_back(elapsedNs(start) / cells);
+
+        start = BenchClock::now();
+        const BigMaze::Solution solution = BigMaze{directory / "newton_bench.maze"}.solve(directory / "newton_bench.dist",
+                                                                                          (std::size_t) 1 << 20);
+        solve.push_back(elapsedNs(start) / cells);
+        sink = (std::uint64_t) solution.solutionLength;
+        bytes = std::max(bytes, solution.bytesRead + solution.bytesWritten);
+    }
+    std::filesystem::remove(directory / "newton_bench.maze");
+    std::filesystem::remove(directory / "newton_bench.dist");
+    report.add("big_maze_generate_cell", size, generate, (std::uint64_t) size * ((size + 7) / 8));
+    report.add("big_maze_solve_cell", size, solve, bytes);
+}
+
+// nivelul construit pe calea din joc, independenta de bakeLevel si de Level::generateLayout: labirintul din
+// Maze::generate, merele din Game::placeApples si bomba trase din acelasi flux SplitMix64
+Level runtimeLevel(const int dim, const std::uint64_t seed) {
+    SplitMix64 rng{seed};
+    Maze maze{dim};
+    maze.generate(rng());
+
+    Level level;
+    level.dim = dim;
+    level.seed = seed;
+    level.wall.resize((std::size_t) dim * dim);
+    for (int row = 0; row < dim; row++) {
+        for (int col = 0; col < dim; col++) {
+            level.wall[(std::size_t) row * dim + col] = maze.isWall(row, col);
+        }
+    }
+    for (const Object &apple: Game::placeApples(maze.getFreeCells(), rng)) {
+        level.apples.push_back(apple.getPosition());
+    }
+    level.bombCol = uniformInt(rng, 2, dim - 2);
+    level.analyze();
+    return level;
+}
+
+// nivelurile din LevelCatalog sunt fixture-uri: trebuie sa fie identice cu cele generate la rulare, iar analiza
+// lor se masoara pe exact aceleasi labirinturi la fiecare rulare
+bool benchBakedLevels(Report &report, const Options &options) {
+    // golden: nivelurile coapte la compilare si cele din generatorul pentru dimensiunile din afara meniului trebuie
+    // sa fie identice cu cele construite de joc din acelasi seed
+    for (const BakedLevel<20> &baked: LevelCatalog::daily) {
+        if (!(runtimeLevel(20, baked.seed) == baked.toLevel())) {
+            std::cerr << "Baked level " << baked.seed << " differs from runtime generation" << std::endl;
+            return false;
+        }
+    }
+    for (std::uint64_t seed = 0; seed < (std::uint64_t) options.seeds; seed++) {
+        if (!(runtimeLevel(40, seed) == Level::generate(40, seed))) {
+            std::cerr << "Generated 40x40 level " << seed << " differs from runtime generation" << std::endl;
+            return false;
+        }
+    }
+
+    std::vector<double> samples;
+    for (const BakedLevel<20> &baked: LevelCatalog::daily) {
+        for (int rep = 0; rep < options.reps; rep++) {
+            const auto start = BenchClock::now();
+            sink = (std::uint64_t) baked.toLevel().parLength; // doar copierea si analiza, fara generare
+            samples.push_back(elapsedNs(start));
+        }
+    }
+    report.add("baked_level_analyze", 20, samples);
+    return true;
+}
+
+std::vector<int> parseSizes(const std::string &list) {
+    std::vector<int> sizes;
+    std::stringstream in(list);
+    std::string item;
+    while (std::getline(in, item, ',')) {
+        sizes.push_back(std::stoi(item));
+    }
+    return sizes;
+}
+
+} // namespace
+
+int main(int argc, char *argv[]) {
+    Options options;
+    ThreadPool::Config pool;
+    const std::vector<std::string> args(argv + 1, argv + argc);
+
+    try {
+        for (std::size_t i = 0; i < args.size(); i++) {
+            const auto value = [&]() -> const std::string & {
+                if (i + 1 >= args.size()) {
+                    throw std::invalid_argument(args[i] + " needs a value");
+                }
+                return args[++i];
+            };
+
+            if (args[i] == "--sizes") {
+                options.sizes = parseSizes(value());
+            }
+            else if (args[i] == "--layout-sizes") {
+                options.layoutSizes = parseSizes(value());
+            }
+            else if (args[i] == "--seeds") {
+                options.seeds = std::stoi(value());
+            }
+            else if (args[i] == "--reps") {
+                options.reps = std::stoi(value());
+            }
+            else if (args[i] == "--out") {
+                options.out = value();
+            }
+            else if (args[i] == "--threads") { // workeri in runtime-ul comun, pe langa thread-ul principal
+                pool.threads = (unsigned) std::stoi(value());
+            }
+            else if (args[i] == "--pin") {
+                pool.pinThreads = true;
+            }
+            else {
+                throw std::invalid_argument(args[i]);
+            }
+        }
+    }
+    catch (const std::exception &e) {
+        std::cerr << "Invalid arguments (" << e.what() << ")" << std::endl
+                  << "Usage: newton_bench [--sizes 10,20,30] [--seeds N] [--reps N] [--out file.csv] [--threads N] [--pin]" << std::endl
+                  << "                    [--layout-sizes 1000,4000,16000]" << std::endl;
+        return 1;
+    }
+
+    if (options.sizes.empty() || options.seeds < 1 || options.reps < 1 ||
+        std::any_of(options.sizes.begin(), options.sizes.end(), [](const int size) { return size < 10; }) ||
+        std::any_of(options.layoutSizes.begin(), options.layoutSizes.end(), [](const int size) { return size < 10; })) {
+        std::cerr << "Sizes must be at least 10, seeds and reps at least 1" << std::endl;
+        return 1;
+    }
+
+    ThreadPool::configureShared(pool);
+
+    // tot ce scrie jocul pe ecran (render, destructori) ajunge intr-un buffer care doar numara octetii
+    CountingBuffer output;
+    std::streambuf *const console = std::cout.rdbuf(&output);
+
+    bool golden = true;
+    {
+        Report report{options.out};
+        golden = benchBakedLevels(report, options) && checkStateDecoder();
+        benchChunkedWalk(report, options);
+        benchBigMaze(report, options);
+        for (const int size: options.sizes) {
+            benchGenerate(report, options, size);
+            benchFreeCells(report, options, size);
+            benchCreateHole(report, options, size);
+            benchApplePlacement(report, options, size);
+            benchAppleField(report, options, size);
+            benchFieldOfView(report, options, size);
+            golden = benchNextHop(report, options, size) && golden;
+            benchHandleEvent(report, options, size);
+            if (size <= 30) { // dimensiunile din meniu; la 1000 x 1000 un joc de bot dureaza prea mult
+                benchBots(report, options, size);
+            }
+            benchRender(report, options, size, output);
+            benchVectorEnv(report, options, size);
+            benchArenaTick(report, options, size);
+            benchStateDelta(report, options, size);
+            benchStateHash(report, options, size);
+            benchLevelGenerate(report, options, size);
+            benchLevelCache(report, options, size);
+            benchLevelTransition(report, options, size);
+        }
+        for (const int size: options.layoutSizes) {
+            benchLayout<RowMajorLayout>(report, options, size, output);
+            benchLayout<TiledLayout>(report, options, size, output);
+            benchLayout<MortonLayout>(report, options, size, output);
+            benchCompressed(report, options, size);
+        }
+    }
+
+    std::cout.rdbuf(console);
+    std::cerr << "Results written to " << options.out << std::endl;
+
+    return golden ? 0 : 1;
+}
@@ -0,0 +1,35 @@
+#ifndef OOP_APPLEPLACEMENT_H
+#define OOP_APPLEPLACEMENT_H
+
+#include <algorithm>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+constexpr int maxApplesPerLevel = 60;
+
+// Regulile de plasare a merelor, scrise independent de generatorul de numere aleatoare si de modul in care sunt
+// stocate celulele libere, ca la carveSidewinder: intre 5 si jumatate din cele freeCount celule libere (cel mult
+// maxApplesPerLevel), fiecare la un index aleator; un index tras de doua ori da un singur mar. randInt(a, b) intoarce
+// un numar din [a, b], iar place(index) primeste indexul celulei libere alese. Game::placeApples, bakeLevel si
+// Level::generateLayout trag astfel aceleasi numere in aceeasi ordine.
+template<typename RandInt, typename Place>
+constexpr void placeApplesOnFreeCells(const int freeCount, RandInt &&randInt, Place &&place) {
+    int lowerLimit = 5;
+    int upperLimit = freeCount / 2;
+    if (upperLimit < lowerLimit) {
+        std::swap(lowerLimit, upperLimit);
+    }
+
+    const int numberOfApples = std::min(randInt(lowerLimit, upperLimit), maxApplesPerLevel);
+    std::vector<std::uint8_t> used((std::size_t) freeCount); // indicii folositi, ca doua mere sa nu fie in aceeasi celula
+    for (int i = 0; i < numberOfApples && freeCount > 0; i++) {
+        const int index = randInt(0, freeCount - 1);
+        if (!used[index]) {
+            used[index] = 1;
+            place(index);
+        }
+    }
+}
+
+#endif //OOP_APPLEPLACEMENT_H
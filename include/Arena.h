@@ -0,0 +1,124 @@
+#ifndef OOP_ARENA_H
+#define OOP_ARENA_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "Maze.h"
+#include "Player.h"
+#include "SplitMix64.h"
+#include "SpscQueue.h"
+#include "StateSync.h"
+
+// Modul competitiv: mai multi jucatori in acelasi labirint, care concureaza pentru aceleasi mere si
+// aceeasi bomba. Tastele sunt cele din Game (w/a/s/d, SPACE, f) si ajung prin cate o coada SPSC pe
+// jucator: producatorul este thread-ul care citeste inputul jucatorului, consumatorul este thread-ul
+// shard-ului care apeleaza tick(). Pe acest drum nu exista lock-uri.
+//
+// Un tick consuma cel mult o tasta per jucator si o aplica in faze, toate fata de aceeasi stare:
+//   1. deplasarile, fiecare jucator independent (jucatorii nu se blocheaza intre ei);
+//   2. culesul: cand mai multi jucatori incearca aceeasi celula, castiga primul in ordinea jucatorilor
+//      rotita cu numarul tick-ului, deci rezultatul depinde doar de input, iar prioritatea circula;
+//   3. exploziile: reuniunea gaurilor tuturor bombelor detonate in tick, deci doua bombe suprapuse
+//      nu distrug nimic de doua ori.
+// Arena se termina cand nu mai raman mere; castiga cel cu cele mai multe, la egalitate id-ul mai mic.
+class Arena {
+public:
+    static constexpr std::size_t inputQueueSize = 64;
+
+    Arena(int mazeSize, int players, std::uint64_t seed, int bombRespawnTicks = 50);
+
+    Arena(const Arena &) = delete;
+    Arena &operator=(const Arena &) = delete;
+
+    bool pushInput(int player, char key); // false daca jucatorul are deja prea multe taste in asteptare
+    void tick();
+
+    [[nodiscard]] bool isFinished() const;
+    [[nodiscard]] int winner() const; // -1 cat timp arena nu s-a terminat
+    [[nodiscard]] std::uint64_t tickCount() const;
+
+    [[nodiscard]] const Maze &getMaze() const;
+    [[nodiscard]] int playerCount() const;
+    [[nodiscard]] std::pair<int, int> playerPosition(int player) const;
+    [[nodiscard]] bool playerHasBomb(int player) const;
+    [[nodiscard]] int score(int player) const;
+    [[nodiscard]] bool hasApple(int row, int col) const;
+    [[nodiscard]] int applesLeft() const;
+    [[nodiscard]] int bombColumn() const; // coloana bombei de pe randul 0, -1 daca nu exista
+
+    // celulele schimbate de ultimul tick
+    [[nodiscard]] const std::vector<std::pair<int, int>> &removedApples() const;
+    [[nodiscard]] const std::vector<std::pair<int, int>> &removedWalls() const;
+
+    void syncState(SyncState &state) const;
+    [[nodiscard]] std::uint64_t stateHash() const; // hash Zobrist al starii dupa ultimul tick, egal cu Zobrist::hash(syncState)
+
+private:
+    void placeApples();
+    void move(int player, char key);
+    void detonate(int player);
+    [[nodiscard]] std::size_t cellIndex(int row, int col) const;
+
+    Maze m_maze;
+    int m_dim;
+    int m_bombRespawnTicks;
+    SplitMix64 m_rng;
+
+    std::vector<Player> m_players;
+    std::vector<int> m_scores;
+    std::vector<SpscQueue<char, inputQueueSize>> m_inputs;
+    std::vector<char> m_actions; // tastele tick-ului curent, refolosit ca tick() sa nu aloce
+
+    std::vector<std::uint8_t> m_apple;
+    int m_applesLeft{};
+    int m_bombCol{};
+    int m_bombRespawnIn{};
+    std::uint64_t m_ticks{};
+    std::uint64_t m_hash{}; // fara pereti; aceia sunt in m_maze.getHash()
+
+    std::vector<std::pair<int, int>> m_removedApples;
+    std::vector<std::pair<int, int>> m_removedWalls;
+};
+
+// Un thread de simulare care avanseaza la perioada fixa toate arenele care i-au fost atribuite. Arenele
+// nu impart stare, asa ca shard-urile nu se sincronizeaza intre ele; se porneste de obicei cate unul pe core.
+class ArenaShard {
+public:
+    using TickListener = std::function<void(const Arena &)>; // apelat pe thread-ul shard-ului dupa fiecare tick
+
+    explicit ArenaShard(std::chrono::microseconds tickPeriod = std::chrono::milliseconds(10));
+    ~ArenaShard();
+
+    ArenaShard(const ArenaShard &) = delete;
+    ArenaShard &operator=(const ArenaShard &) = delete;
+
+    // addArena si setTickListener doar inainte de start()
+    Arena &addArena(int mazeSize, int players, std::uint64_t seed);
+    void setTickListener(TickListener listener);
+
+    void start();
+    void stop();
+
+    [[nodiscard]] std::uint64_t rounds() const;
+    [[nodiscard]] std::chrono::nanoseconds maxRoundTime() const; // cea mai lunga runda (un tick al fiecarei arene)
+
+private:
+    void run();
+
+    std::chrono::microseconds m_tickPeriod;
+    std::vector<std::unique_ptr<Arena>> m_arenas;
+    TickListener m_listener;
+    std::thread m_thread;
+    std::atomic<bool> m_running{false};
+    std::atomic<std::uint64_t> m_rounds{0};
+    std::atomic<std::int64_t> m_maxRoundNs{0};
+};
+
+#endif //OOP_ARENA_H
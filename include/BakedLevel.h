@@ -0,0 +1,93 @@
+#ifndef OOP_BAKEDLEVEL_H
+#define OOP_BAKEDLEVEL_H
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+#include "ApplePlacement.h"
+#include "FixedMaze.h"
+#include "Level.h"
+#include "SplitMix64.h"
+#include "Zobrist.h"
+
+// Partea generata a unui Level (labirint, mere, bomba), calculabila la compilare. Level::generate foloseste aceeasi
+// functie pentru dimensiunile 10..30, deci un nivel copt in binar este identic bit cu bit cu cel generat la rulare
+// din acelasi seed; analiza (distante, traseu) se face abia in toLevel().
+template<int Dim>
+struct BakedLevel {
+    static constexpr int maxApples = maxApplesPerLevel;
+
+    std::uint64_t seed{};
+    std::array<std::uint8_t, Dim * Dim> wall{}; // rand cu rand, ca Level::wall
+    std::array<std::pair<int, int>, maxApples> apples{};
+    int appleCount{};
+    int bombCol{};
+
+    // hash Zobrist al peretilor, ca Maze::getHash; o amprenta scurta pentru fixture-uri
+    [[nodiscard]] constexpr std::uint64_t wallHash() const {
+        std::uint64_t hash = 0;
+        for (int cell = 0; cell < Dim * Dim; cell++) {
+            if (wall[cell]) {
+                hash ^= Zobrist::cell(Zobrist::Feature::Wall, Dim, cell / Dim, cell % Dim);
+            }
+        }
+        return hash;
+    }
+
+    [[nodiscard]] Level toLevel() const {
+        Level level = layout();
+        level.analyze();
+        return level;
+    }
+
+    [[nodiscard]] Level layout() const { // fara analiza
+        Level level;
+        level.dim = Dim;
+        level.seed = seed;
+        level.wall.assign(wall.begin(), wall.end());
+        level.apples.assign(apples.begin(), apples.begin() + appleCount);
+        level.bombCol = bombCol;
+        return level;
+    }
+};
+
+template<int Dim>
+constexpr BakedLevel<Dim> bakeLevel(const std::uint64_t seed) {
+    SplitMix64 rng{seed};
+    BakedLevel<Dim> level;
+    level.seed = seed;
+
+    FixedMaze<Dim, Dim> maze;
+    maze.generate(rng());
+
+    std::array<std::pair<int, int>, Dim * Dim> freeCells{}; // ca Maze::getFreeCells
+    int freeCount = 0;
+    for (int row = 0; row < Dim; row++) {
+        for (int col = 0; col < Dim; col++) {
+            level.wall[row * Dim + col] = maze.isWall(row, col);
+            if (row > 0 && !maze.isWall(row, col)) {
+                freeCells[freeCount++] = {row, col};
+            }
+        }
+    }
+
+    placeApplesOnFreeCells(freeCount, [&rng](const int from, const int to) { return uniformInt(rng, from, to); },
+                           [&level, &freeCells](const int index) { level.apples[level.appleCount++] = freeCells[index]; });
+
+    level.bombCol = uniformInt(rng, 2, Dim - 2);
+    return level;
+}
+
+template<int Dim, std::size_t Count>
+constexpr std::array<BakedLevel<Dim>, Count> bakeLevels(const std::array<std::uint64_t, Count> &seeds) {
+    std::array<BakedLevel<Dim>, Count> levels{};
+    for (std::size_t i = 0; i < Count; i++) {
+        levels[i] = bakeLevel<Dim>(seeds[i]);
+    }
+    return levels;
+}
+
+#endif //OOP_BAKEDLEVEL_H
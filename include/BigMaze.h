@@ -0,0 +1,68 @@
+#ifndef OOP_BIGMAZE_H
+#define OOP_BIGMAZE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <iostream>
+#include <utility>
+#include <vector>
+
+// Labirinturi mai mari decat memoria (nivelurile de stres, 10^10+ celule), tinute intr-un fisier:
+//
+//   "NITB", versiune, dim, seed, locuri pentru mere, numarul de mere, merele (rand, coloana), apoi liniile, fiecare
+//   pe (dim + 7) / 8 octeti (bitul 1 = zid)
+//
+// generate() scrie liniile pe masura ce Sidewinder le termina (in memorie stau doar trei linii), iar labirintul este
+// identic cu Maze::generate(seed). Merele sunt alese uniform dintre celulele libere (fara prima linie) prin reservoir
+// sampling, in aceeasi trecere.
+//
+// solve() calculeaza distantele de la (0, 0) cu BFS pe benzi de linii: fiecare banda se incarca, se relaxeaza
+// pornind de la distantele ei si ale liniilor vecine si se scrie inapoi. Benzile se parcurg alternativ de sus in jos
+// si de jos in sus, sarind peste cele ale caror vecine nu s-au schimbat, pana cand nu mai e nimic de imbunatatit.
+// Memoria folosita este limitata de memoryBudget, iar fisierele sunt citite si scrise doar secvential, banda cu banda.
+class BigMaze {
+public:
+    struct Solution {
+        std::uint64_t reachableCells{};
+        std::pair<int, int> goal{-1, -1}; // cea mai din dreapta celula libera de pe ultima linie
+        std::int64_t solutionLength = -1; // pasi de la (0, 0) la goal; -1 daca nu se ajunge fara bomba
+        int apples{};
+        int reachableApples{};
+        int sweeps{}; // treceri sus-jos sau jos-sus prin benzi
+        int bandRows{};
+        std::uint64_t bytesRead{};
+        std::uint64_t bytesWritten{};
+    };
+
+    static void generate(const std::filesystem::path &path, int dim, std::uint64_t seed, int apples = 60);
+
+    explicit BigMaze(std::filesystem::path path); // citeste antetul; arunca daca fisierul nu e valid
+
+    // distances = fisier de lucru cu cate 4 octeti pe celula; este suprascris
+    [[nodiscard]] Solution solve(const std::filesystem::path &distances, std::size_t memoryBudget) const;
+
+    // liniile [row, row + count), despachetate: cells[i * dim + col] = 1 pentru zid
+    void readRows(int row, int count, std::vector<std::uint8_t> &cells) const;
+
+    // imagini PBM/PGM (vezi PnmExport.h), citite si scrise rand cu rand; harta foloseste fisierul de distante lasat
+    // de solve()
+    void writePbm(std::ostream &out) const;
+    void writeHeatmap(const std::filesystem::path &distances, std::ostream &out) const;
+
+    [[nodiscard]] int getSize() const;
+    [[nodiscard]] std::uint64_t getSeed() const;
+    [[nodiscard]] const std::vector<std::pair<int, int>> &getApples() const;
+
+private:
+    [[nodiscard]] std::uint64_t rowBytes() const;
+    void unpackRow(const char *packed, std::uint8_t *cells) const;
+
+    std::filesystem::path m_path;
+    int m_dim{};
+    std::uint64_t m_seed{};
+    std::vector<std::pair<int, int>> m_apples;
+    std::uint64_t m_rowsOffset{}; // unde incep liniile in fisier
+};
+
+#endif //OOP_BIGMAZE_H
@@ -0,0 +1,126 @@
+#ifndef OOP_BOT_H
+#define OOP_BOT_H
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "Game.h"
+#include "NextHopTable.h"
+
+// Jucator automat: la fiecare pas se uita la starea jocului si alege o tasta, exact ca un om (w/a/s/d, SPACE, f, q).
+// Jocul il conduce runBotGames prin Game::step, deci botul respecta aceleasi reguli: merele se culeg cu SPACE,
+// bomba se ia de pe randul 0, se detoneaza cu f, iar jocul se castiga la iesirea (0, 0) dupa ultimul mar.
+class BotPolicy {
+public:
+    virtual ~BotPolicy() = default;
+
+    virtual void begin(const Game &game) = 0; // la inceputul fiecarui joc
+    virtual int nextKey(const Game &game) = 0;
+    [[nodiscard]] virtual std::string name() const = 0;
+
+    // "greedy", "route" sau "bomb"; arunca std::invalid_argument pentru alt nume
+    static std::unique_ptr<BotPolicy> create(const std::string &name);
+};
+
+// Peretii labirintului copiati cu o bordura de ziduri, pentru BFS-urile botilor: vecinii unei celule sunt cell +- 1 si
+// cell +- stride, fara verificari de margini. Campurile de distante folosesc aceiasi indecsi, -1 unde nu se ajunge.
+class BotGrid {
+public:
+    void assign(const Maze &maze);
+
+    [[nodiscard]] std::int32_t cell(int row, int col) const;
+    [[nodiscard]] std::pair<int, int> position(std::int32_t cell) const;
+    [[nodiscard]] bool isOpen(std::int32_t cell) const;
+    [[nodiscard]] std::int32_t cellCount() const; // cu tot cu bordura
+
+    void distancesFrom(std::int32_t source, std::vector<std::int32_t> &distance);
+    // tasta pentru un pas spre un vecin cu distanta mai mica cu 1; 0 daca cell este tinta sau nu ajunge la ea
+    [[nodiscard]] int downhill(std::int32_t cell, const std::vector<std::int32_t> &distance) const;
+
+private:
+    int m_stride{};
+    std::int32_t m_offsets[4]{}; // in ordinea tastelor w, a, s, d
+    std::vector<std::uint8_t> m_open;
+    std::vector<std::int32_t> m_queue;
+};
+
+// Mereu spre cel mai apropiat mar, ales dupa Game::appleDistances(); pasul spre el vine dintr-o NextHopTable cu
+// randuri doar pentru mere si iesire. Renunta (q) cand merele ramase nu se pot atinge.
+class GreedyPolicy : public BotPolicy {
+public:
+    void begin(const Game &game) override;
+    int nextKey(const Game &game) override;
+    [[nodiscard]] std::string name() const override;
+
+private:
+    void buildTable(const Game &game);
+
+    NextHopTable m_table;
+    std::uint64_t m_tableWalls{}; // Maze::getHash() al labirintului pentru care este construita tabela
+};
+
+// Planifica la inceput un traseu scurt prin toate merele accesibile si inapoi la iesire (cel mai apropiat vecin,
+// imbunatatit cu 2-opt, pe distantele date de cate un BFS din fiecare mar) si il urmeaza cu o NextHopTable construita
+// pentru merele din traseu si iesire. Renunta cand nu mai are ce culege.
+// Planul tine doar de pereti, deci cheia lui este hash-ul Zobrist al peretilor (Maze::getHash): cand labirintul se
+// schimba (o bomba, a botului sau a altcuiva) cheia nu se mai potriveste si traseul se recalculeaza.
+class RoutePolicy : public BotPolicy {
+public:
+    void begin(const Game &game) override;
+    int nextKey(const Game &game) override;
+    [[nodiscard]] std::string name() const override;
+
+protected:
+    virtual int stuck(const Game &game); // mai sunt mere, dar niciunul accesibil
+    void plan(const Game &game); // traseul de la pozitia curenta, pe labirintul curent
+    void buildTable(const Game &game); // pentru m_route si iesire
+
+    BotGrid m_grid; // labirintul din momentul planificarii
+    std::vector<std::pair<int, int>> m_route; // merele, in ordinea culegerii
+    NextHopTable m_table; // primul pas spre fiecare mar din m_route si spre iesire
+    std::size_t m_next{}; // urmatorul mar din traseu
+    std::uint64_t m_plannedWalls{}; // Maze::getHash() al labirintului pe care s-a facut planul
+};
+
+// Ca RoutePolicy, dar cand merele ramase sunt inchise ia bomba de pe randul 0 (asteptand-o daca trebuie) si o
+// detoneaza in cel mai apropiat loc din care gaura uneste zona jucatorului cu zona unui mar ramas, apoi replanifica.
+class BombAwarePolicy : public RoutePolicy {
+public:
+    void begin(const Game &game) override;
+    [[nodiscard]] std::string name() const override;
+
+protected:
+    int stuck(const Game &game) override;
+
+private:
+    [[nodiscard]] bool findBlastCell(const Game &game); // completeaza m_blastCell si m_toBlast
+
+    std::pair<int, int> m_blastCell{-1, -1};
+    std::vector<std::int32_t> m_toBlast;
+    int m_bombCol{-1}; // coloana pentru care este calculat m_toBomb
+    std::vector<std::int32_t> m_toBomb;
+};
+
+struct BotStats {
+    int games{};
+    int wins{};
+    std::uint64_t keys{}; // taste trimise in total
+    double seconds{};
+
+    [[nodiscard]] double gamesPerSecond() const;
+    [[nodiscard]] double winRate() const;
+};
+
+// games jocuri fara afisare pe nivelurile Level::generate(mazeSize, ...) derivate din seed, cu limita de timp din
+// campanie; ceasul jocului avanseaza cu keyInterval la fiecare tasta, deci rezultatul depinde doar de seed. Jocurile
+// se impart pe ThreadPool::shared(), fiecare bucata cu politica ei (BotPolicy::create(policyName)), iar statisticile
+// se aduna in ordinea bucatilor, deci nici numarul de thread-uri nu schimba rezultatul (doar seconds).
+// Arunca std::invalid_argument pentru un nume de politica necunoscut.
+BotStats runBotGames(const std::string &policyName, int mazeSize, int games, std::uint64_t seed,
+                     std::chrono::milliseconds keyInterval = std::chrono::milliseconds(100));
+
+#endif //OOP_BOT_H
@@ -0,0 +1,61 @@
+#ifndef OOP_BROADCAST_H
+#define OOP_BROADCAST_H
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <vector>
+
+// Un mesaj codat o singura data si impartit de toti abonatii; fiecare abonat tine doar referinte.
+using SharedFrame = std::shared_ptr<const std::vector<std::uint8_t>>;
+
+// Difuzarea aceluiasi flux (keyframe-uri si delta-uri) catre multi abonati pe socket-uri neblocante. Cadrele nu
+// se copiaza per abonat: cozile contin referinte la acelasi buffer, iar flush() le trimite cu writev direct
+// din bufferele comune.
+//
+// Un abonat care nu citeste destul de repede nu acumuleaza cadre la nesfarsit: cand coada lui ar depasi
+// maxQueuedBytes, delta-urile in asteptare sunt aruncate si abonatul sare peste tot pana la urmatorul keyframe
+// (needsKeyframe() ii spune producatorului sa genereze unul). Un cadru trimis partial se termina intotdeauna,
+// ca fluxul sa ramana aliniat pe granite de mesaj.
+class Broadcast {
+public:
+    struct Subscriber {
+        std::uint64_t id{}; // identificatorul abonatului pentru apelant (de exemplu sesiunea serverului)
+        int fd{-1};
+        std::deque<SharedFrame> queue;
+        std::size_t offset{}; // cat din primul cadru a fost deja trimis
+        std::size_t queuedBytes{};
+        bool waitingKeyframe{true}; // abonat nou sau ramas in urma
+        std::uint64_t dropped{}; // cadre aruncate pentru ca abonatul era prea lent
+
+        [[nodiscard]] bool hasPending() const { return !queue.empty(); }
+    };
+
+    enum class FlushResult {
+        Done,    // coada e goala
+        Pending, // socket-ul e plin; se reia la EPOLLOUT
+        Failed   // conexiunea s-a inchis
+    };
+
+    explicit Broadcast(std::size_t maxQueuedBytes = 64 << 10);
+
+    void add(Subscriber &subscriber); // abonatul trebuie sa traiasca pana la remove()
+    void remove(const Subscriber &subscriber);
+
+    // pune cadrul in coada fiecarui abonat; trimiterea se face separat, cu flush()
+    void publish(const SharedFrame &frame, bool keyframe);
+    static FlushResult flush(Subscriber &subscriber);
+
+    [[nodiscard]] bool needsKeyframe() const;
+    [[nodiscard]] const std::vector<Subscriber *> &subscribers() const;
+
+private:
+    static void dropPending(Subscriber &subscriber); // pastreaza doar cadrul trimis partial, daca exista
+
+    std::size_t m_maxQueuedBytes;
+    std::vector<Subscriber *> m_subscribers;
+    bool m_needsKeyframe{};
+};
+
+#endif //OOP_BROADCAST_H
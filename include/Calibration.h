@@ -0,0 +1,40 @@
+#ifndef OOP_CALIBRATION_H
+#define OOP_CALIBRATION_H
+
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+#include "DifficultyTable.h"
+#include "ThreadPool.h"
+
+// Calibrarea Monte Carlo a timpului acordat nivelurilor. Pentru fiecare dimensiune un jucator simulat joaca games
+// niveluri alese dupa regulile din LevelPipeline, fara limita practica de timp, si se noteaza de cat timp a avut
+// nevoie raportat la traseul de referinta. secondsPerStep este cuantila targetWinRate a acestor rapoarte: cu limita
+// DifficultyTable::timeLimit, cel putin proportia tinta din jocurile simulate s-ar fi terminat la timp.
+//
+// Jucatorul simulat merge spre cel mai apropiat mar (ca GreedyPolicy), dar la fiecare tasta greseste cu
+// probabilitatea mistakeRate, apasand o directie la intamplare, si apasa cate o tasta la un interval ales pentru
+// fiecare joc intre fastestKey si slowestKey. Jocurile tuturor dimensiunilor se impart pe thread pool, incepand cu
+// cele mari; rezultatul depinde doar de configuratie, nu si de numarul de thread-uri.
+struct CalibrationConfig {
+    std::vector<int> sizes{10, 15, 20, 25, 30, 50, 75, 100, 150, 200, 300, 500, 750, 1000};
+    int games = 256; // pe dimensiune
+    double targetWinRate = 0.8;
+    double mistakeRate = 0.1;
+    std::chrono::milliseconds fastestKey{150};
+    std::chrono::milliseconds slowestKey{400};
+    std::uint64_t seed = 1;
+};
+
+struct CalibrationResult {
+    DifficultyTable table;
+    int games{}; // jocuri simulate, in total
+    std::uint64_t keys{};
+    double seconds{};
+};
+
+// arunca std::invalid_argument pentru o configuratie invalida (dimensiuni sub 10, games < 1, rate in afara (0, 1])
+CalibrationResult calibrate(const CalibrationConfig &config, ThreadPool &pool = ThreadPool::shared());
+
+#endif //OOP_CALIBRATION_H
@@ -0,0 +1,84 @@
+#ifndef OOP_CHUNKEDMAZE_H
+#define OOP_CHUNKEDMAZE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <list>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+// Labirint fara margini pentru modul infinit: lumea este impartita in chunk-uri de chunkSize x chunkSize, generate
+// doar cand sunt atinse. Un chunk depinde numai de (seed-ul lumii, rand, coloana), deci poate fi aruncat si regenerat
+// identic; in memorie raman cel mult maxChunks, cele folosite cel mai recent. Doar chunk-urile modificate de
+// createHole se salveaza pe disc (cand sunt eliminate si la flush()), ca memoria si discul sa nu creasca doar pentru
+// ca jucatorul merge departe.
+//
+// Fiecare chunk este un labirint Sidewinder, deci are prima linie complet libera si, pe ultima linie, deschideri in
+// jos. Prima linie trece continuu in chunk-urile vecine din stanga si din dreapta, iar deschiderile de pe ultima linie
+// dau in prima linie a chunk-ului de dedesubt, deci marginile se potrivesc oricand ar fi generate chunk-urile si
+// reteaua principala trece prin toata lumea. Buzunarele inchise din interiorul unui chunk sunt ca in jocul obisnuit:
+// se ajunge la ele cu bomba.
+class ChunkedMaze {
+public:
+    static constexpr int chunkSize = 32;
+
+    struct Stats {
+        std::uint64_t generated{};
+        std::uint64_t loaded{}; // citite de pe disc (modificate anterior)
+        std::uint64_t evicted{};
+        std::uint64_t saved{};
+    };
+
+    ChunkedMaze(std::uint64_t worldSeed, std::filesystem::path directory, std::size_t maxChunks = 1024);
+    ~ChunkedMaze(); // salveaza chunk-urile modificate
+
+    ChunkedMaze(const ChunkedMaze &) = delete;
+    ChunkedMaze &operator=(const ChunkedMaze &) = delete;
+
+    // coordonatele sunt ale lumii si pot fi si negative
+    bool isWall(int row, int col);
+    bool isPositionAvailable(int row, int col);
+    void createHole(int row, int col); // ca Maze::createHole, si peste marginile chunk-urilor
+    // incarca chunk-urile din patratul de latura 2 * radius + 1 in jurul chunk-ului celulei; nu face nimic daca a fost
+    // deja apelat pentru acelasi chunk
+    void prefetch(int row, int col, int radius);
+    void flush(); // salveaza chunk-urile modificate aflate in memorie
+
+    [[nodiscard]] std::size_t residentChunks() const;
+    [[nodiscard]] Stats stats() const;
+
+    [[nodiscard]] static std::uint64_t chunkSeed(std::uint64_t worldSeed, int chunkRow, int chunkCol);
+
+private:
+    using Key = std::pair<int, int>; // (randul, coloana) chunk-ului
+
+    struct KeyHash {
+        std::size_t operator()(const Key &key) const;
+    };
+
+    struct Chunk {
+        std::vector<std::uint8_t> wall; // chunkSize * chunkSize, rand cu rand
+        bool modified = false;
+        std::list<Key>::iterator lru;
+    };
+
+    Chunk &chunkAt(int row, int col); // chunk-ul care contine celula; il incarca sau il genereaza daca lipseste
+    [[nodiscard]] std::filesystem::path chunkPath(const Key &key) const;
+    void save(const Key &key, const Chunk &chunk);
+
+    std::uint64_t m_worldSeed;
+    std::filesystem::path m_directory;
+    std::size_t m_maxChunks;
+
+    std::unordered_map<Key, Chunk, KeyHash> m_chunks;
+    std::list<Key> m_lru; // cel mai recent folosit in fata
+    Key m_lastKey{};
+    Chunk *m_last = nullptr; // cele mai multe accese consecutive sunt in acelasi chunk
+    Key m_prefetchedKey{};
+    int m_prefetchedRadius = -1;
+    Stats m_stats;
+};
+
+#endif //OOP_CHUNKEDMAZE_H
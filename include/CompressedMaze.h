@@ -0,0 +1,93 @@
+#ifndef OOP_COMPRESSEDMAZE_H
+#define OOP_COMPRESSEDMAZE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <utility>
+#include <vector>
+
+// Labirint cu acelasi API ca Maze, dar tinut comprimat: grila este impartita in tile-uri de tileSize x tileSize,
+// fiecare comprimat separat, iar accesele trec printr-un cache mic de tile-uri decomprimate (cele mai recent
+// folosite). Un tile modificat de createHole se recomprima cand iese din cache.
+//
+// Un tile se codeaza in modul cel mai scurt dintre:
+//   - RLE: lungimile secventelor alternante de ziduri si celule libere, ca varint (tile-uri uniforme)
+//   - context: fiecare celula, rand cu rand, cu un range coder binar adaptiv (ca in LZMA), probabilitatea fiind
+//     aleasa dupa vecinii deja codati (sus, stanga, sus-stanga, sus-dreapta, doua randuri mai sus) si paritatea
+//     randului. Sidewinder lasa aproape toata informatia in pozitiile deschiderilor, asa ca RLE sau LZ pe biti nu
+//     bat impachetarea simpla (1 bit pe celula); modelul de context ajunge la ~0.7 biti pe celula.
+class CompressedMaze {
+public:
+    static constexpr int tileSize = 64;
+
+    struct Stats {
+        std::uint64_t hits{};
+        std::uint64_t misses{}; // tile-uri decomprimate
+        std::uint64_t recompressed{}; // tile-uri modificate scrise inapoi
+    };
+
+    explicit CompressedMaze(int dim, std::size_t cacheTiles = 16);
+
+    friend std::ostream &operator<<(std::ostream &out, const CompressedMaze &maze) {
+        maze.print(out);
+        return out;
+    }
+
+    bool isPositionAvailable(int row, int col);
+    void generate();
+    void generate(std::uint64_t seed); // identic cu Maze::generate(seed); in memorie sta o singura banda de tile-uri
+    void assign(const std::vector<std::uint8_t> &wall);
+    void createHole(int row, int col);
+
+    std::vector<std::pair<int, int>> getFreeCells(); // in aceeasi ordine ca Maze::getFreeCells
+
+    [[nodiscard]] bool isWall(int row, int col) const;
+    [[nodiscard]] int getSize() const;
+
+    // indici rand cu rand, pentru datele tinute separat pe celula
+    [[nodiscard]] std::size_t cellIndex(const int row, const int col) const { return (std::size_t) row * m_dim + col; }
+    [[nodiscard]] std::size_t cellCount() const { return (std::size_t) m_dim * m_dim; }
+
+    [[nodiscard]] std::uint64_t getHash() const;
+    [[nodiscard]] std::uint64_t computeHash() const;
+
+    void flush(); // recomprima tile-urile modificate din cache
+    [[nodiscard]] std::size_t compressedBytes() const; // doar datele tile-urilor, fara cache
+    [[nodiscard]] Stats stats() const;
+
+private:
+    struct CachedTile {
+        int tile = -1;
+        std::vector<std::uint8_t> wall; // tileSize * tileSize, rand cu rand
+        bool dirty = false;
+        std::uint64_t lastUse{};
+    };
+
+    template<typename RandInt>
+    void generateWith(RandInt &&randInt);
+
+    [[nodiscard]] bool isInside(int row, int col) const;
+    [[nodiscard]] int tileRows(int tileRow) const; // tile-urile de pe margine pot fi mai mici
+    [[nodiscard]] int tileCols(int tileCol) const;
+    CachedTile &cached(int row, int col) const; // tile-ul celulei, decomprimat in cache
+    void store(int tile, const std::uint8_t *cells, int stride) const; // comprima tile-ul si il pune in m_tiles
+    void decode(int tile, std::uint8_t *cells) const; // stride tileSize; ia si modificarile din cache
+    // apeleaza visit(row, cells) pentru fiecare rand, in ordine; in memorie sta o banda de tile-uri
+    template<typename Visit>
+    void forEachRow(Visit &&visit) const;
+    void print(std::ostream &out) const;
+
+    int m_dim;
+    int m_tilesPerRow;
+    // cache-ul se schimba si la citire, iar un tile scos din cache se recomprima
+    mutable std::vector<std::vector<std::uint8_t>> m_tiles; // datele comprimate, rand cu rand
+    mutable std::size_t m_compressedBytes{};
+    mutable std::vector<CachedTile> m_cache;
+    mutable int m_lastSlot = -1; // cele mai multe accese consecutive sunt in acelasi tile
+    mutable std::uint64_t m_clock{};
+    mutable Stats m_stats;
+    std::uint64_t m_hash{};
+};
+
+#endif //OOP_COMPRESSEDMAZE_H
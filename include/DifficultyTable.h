@@ -0,0 +1,52 @@
+#ifndef OOP_DIFFICULTYTABLE_H
+#define OOP_DIFFICULTYTABLE_H
+
+#include <chrono>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+#include "Level.h"
+
+// Timpul acordat unui nivel: secondsPerStep(dimensiune) secunde pentru fiecare pas al traseului de referinta
+// (Level::parLength), cel putin minSeconds. Valorile vin din calibrare (vezi Calibration.h), cate una pe dimensiune,
+// iar intre doua dimensiuni din tabela se interpoleaza liniar. O tabela goala pastreaza regula fixa de dinainte
+// (legacyTimeLimit), aceeasi pentru jocul obisnuit si pentru nivelurile pregatite.
+//
+// Fisierul este CSV, cu antet: size,seconds_per_step,target_win_rate,win_rate,games. Jocul citeste doar primele
+// doua coloane; celelalte spun cum a fost obtinut randul.
+class DifficultyTable {
+public:
+    struct Row {
+        int size{};
+        double secondsPerStep{};
+        double targetWinRate{}; // proportia de jocuri simulate care trebuia sa incapa in timp
+        double winRate{}; // proportia care chiar a incaput, cu limitele rotunjite la secunda
+        int games{};
+    };
+
+    static constexpr const char *defaultPath = "difficulty.csv";
+    static constexpr long long minSeconds = 10;
+
+    // tabela folosita de joc; se incarca la pornire, inainte sa existe alte thread-uri care o citesc
+    static DifficultyTable &shared();
+
+    static DifficultyTable load(const std::string &path); // arunca std::runtime_error
+    static DifficultyTable readCsv(std::istream &in); // arunca std::runtime_error la randuri invalide
+    void save(const std::string &path) const;
+    void writeCsv(std::ostream &out) const;
+
+    void setRow(const Row &row); // inlocuieste randul cu aceeasi dimensiune; randurile raman sortate
+    [[nodiscard]] const std::vector<Row> &rows() const;
+    [[nodiscard]] bool empty() const;
+
+    [[nodiscard]] double secondsPerStep(int size) const; // interpolat; tabela nu trebuie sa fie goala
+    [[nodiscard]] std::chrono::seconds timeLimit(const Level &level) const;
+    [[nodiscard]] static std::chrono::seconds timeLimit(const Level &level, double secondsPerStep);
+    [[nodiscard]] static std::chrono::seconds legacyTimeLimit(std::size_t apples); // un minut la 10 mere, minim unul
+
+private:
+    std::vector<Row> m_rows; // crescator dupa size
+};
+
+#endif //OOP_DIFFICULTYTABLE_H
@@ -0,0 +1,50 @@
+#ifndef OOP_DISTANCEFIELD_H
+#define OOP_DISTANCEFIELD_H
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "Maze.h"
+
+// Distanta de la fiecare celula libera la cea mai apropiata sursa (de exemplu merele ramase), calculata o data cu un
+// BFS pornit din toate sursele si apoi actualizata doar local:
+//   - removeSource: se sterg doar celulele a caror sursa cea mai apropiata era cea scoasa (regiunea ei, conexa) si
+//     se reumplu din marginea regiunii; distantele celorlalte celule nu se pot schimba
+//   - openAround: dupa Maze::createHole distantele doar scad, deci se propaga scaderile pornind de la celulele
+//     deschise, cat timp gasesc un drum mai scurt
+// Citirea este O(1) pe celula, deci indiciile, boti si HUD-ul nu mai au nevoie de BFS-ul lor.
+class DistanceField {
+public:
+    static constexpr std::int32_t unreachable = -1;
+
+    void reset(const Maze &maze, const std::vector<std::pair<int, int>> &sources);
+    void removeSource(int row, int col); // nu face nimic daca (row, col) nu este sursa
+    void openAround(const Maze &maze, int row, int col); // dupa maze.createHole(row, col)
+
+    [[nodiscard]] std::int32_t distance(int row, int col) const; // unreachable daca nu se ajunge la nicio sursa
+    [[nodiscard]] std::pair<int, int> nearestSource(int row, int col) const; // (-1, -1) daca nu se ajunge
+    [[nodiscard]] std::size_t lastUpdateCells() const; // celule atinse de ultima actualizare
+
+private:
+    static constexpr std::int32_t infinity = INT32_MAX;
+
+    [[nodiscard]] std::int32_t cell(int row, int col) const; // indexul in grila cu bordura
+    // cea mai buna distanta prin vecini pentru cell; intoarce false daca niciun vecin nu ajunge la o sursa
+    bool relaxFromNeighbours(std::int32_t cell);
+    void propagate(); // BFS din m_seeds, fiecare cu distanta lui
+
+    // grilele au o bordura de ziduri, ca vecinii sa fie doar cell +- 1 si cell +- m_stride, fara verificari de margini
+    int m_dim{};
+    int m_stride{}; // m_dim + 2
+    std::int32_t m_offsets[4]{};
+    std::vector<std::uint8_t> m_open; // copia peretilor din labirint: 1 pentru celulele libere
+    std::vector<std::int32_t> m_distance; // infinity pentru ziduri si celulele fara sursa
+    std::vector<std::int32_t> m_owner; // celula sursei celei mai apropiate, -1 daca nu exista
+    std::vector<std::pair<std::int32_t, std::int32_t>> m_seeds; // (distanta, celula)
+    std::vector<std::int32_t> m_queue;
+    std::size_t m_lastUpdateCells{};
+};
+
+#endif //OOP_DISTANCEFIELD_H
@@ -0,0 +1,33 @@
+#ifndef OOP_ENDLESSGAME_H
+#define OOP_ENDLESSGAME_H
+
+#include <cstdint>
+#include <filesystem>
+#include <string>
+
+#include "ChunkedMaze.h"
+#include "Player.h"
+
+// Modul infinit: jucatorul exploreaza un ChunkedMaze, iar pe ecran se vede doar fereastra din jurul lui. Bomba (F)
+// poate fi folosita oricand; gaurile facute raman in lume si la urmatoarea pornire cu acelasi seed si director.
+class EndlessGame {
+public:
+    static constexpr int viewRows = 21;
+    static constexpr int viewCols = 61;
+
+    EndlessGame(std::uint64_t worldSeed, const std::filesystem::path &directory, std::size_t maxChunks = 1024);
+
+    void run(); // joc interactiv, pana la Q
+    bool step(int key_pressed); // false dupa Q
+    void renderFrame(std::string &frame);
+
+    [[nodiscard]] const Player &getPlayer() const;
+    [[nodiscard]] const ChunkedMaze &getWorld() const;
+
+private:
+    ChunkedMaze m_world;
+    Player m_player;
+    int m_farthest = 0; // cea mai mare distanta Manhattan fata de start
+};
+
+#endif //OOP_ENDLESSGAME_H
@@ -0,0 +1,48 @@
+#ifndef OOP_FIELDOFVIEW_H
+#define OOP_FIELDOFVIEW_H
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "Maze.h"
+
+// Celulele pe care jucatorul le vede dintr-o pozitie, pana la o raza data (ceata de razboi). Se calculeaza cu
+// recursive shadowcasting: fiecare din cele 8 octante se parcurge rand cu rand, departandu-se de jucator, si un zid
+// imparte conul de vedere in conul din stanga lui, cercetat recursiv, si cel din dreapta, care continua. Pe fiecare
+// rand se parcurg doar celulele din con, deci costul tine de cate celule se vad, nu de raza sau de labirint: intr-un
+// labirint generat, zidurile dese opresc vederea dupa cel mult cateva sute de celule si cateva microsecunde.
+//
+// Celulele vazute se marcheaza cu numarul calculului curent (m_stamp), asa ca un calcul nou nu sterge nimic;
+// visibleCells() le da in ordinea in care au fost gasite, pentru afisare.
+class FieldOfView {
+public:
+    void reset(const Maze &maze, int radius, int row, int col); // copia peretilor si primul calcul
+    void moveTo(int row, int col); // jucatorul s-a mutat
+    // dupa maze.createHole(row, col); recalculeaza doar daca s-a deschis o celula aflata in raza
+    void openAround(const Maze &maze, int row, int col);
+
+    [[nodiscard]] bool isVisible(int row, int col) const; // false si pentru pozitii din afara labirintului
+    [[nodiscard]] const std::vector<std::pair<int, int>> &visibleCells() const;
+    [[nodiscard]] std::pair<int, int> origin() const;
+    [[nodiscard]] int radius() const;
+
+private:
+    void compute();
+    // un rand al unei octante si, recursiv, conurile de dupa zidurile gasite; slope = dx / dy, de la start la end
+    void castLight(int distance, double start, double end, int xx, int xy, int yx, int yy);
+    void markVisible(int row, int col);
+
+    int m_dim{};
+    int m_radius{};
+    int m_radiusSquared{}; // r * (r + 1): cercul fara colturile ascutite pe care le-ar da r * r
+    int m_row{};
+    int m_col{};
+    std::vector<std::uint8_t> m_wall; // copia peretilor, dim * dim, rand cu rand
+    std::vector<std::uint32_t> m_stamp; // m_generation pentru celulele vazute din pozitia curenta
+    std::uint32_t m_generation{};
+    std::vector<std::pair<int, int>> m_visible;
+};
+
+#endif //OOP_FIELDOFVIEW_H
@@ -0,0 +1,154 @@
+#ifndef OOP_FIXEDMAZE_H
+#define OOP_FIXEDMAZE_H
+
+#include <array>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "Sidewinder.h"
+#include "SplitMix64.h"
+
+// Labirint cu dimensiunea cunoscuta la compilare, pentru dimensiunile jucate aproape mereu (10..30). Celulele stau
+// intr-un singur std::array cu o margine de o celula in jur, marcata ca zid, deci vecinii oricarei celule din
+// interior sunt la deplasamente constante (neighbours, ring) si nu mai trebuie verificate limitele. Cu dimensiunea
+// constanta, compilatorul poate desface buclele pe linii si pe vecini.
+//
+// Pentru acelasi seed, generate() da exact labirintul lui Maze::generate(seed).
+template<int Rows, int Cols>
+class FixedMaze {
+public:
+    static_assert(Rows > 0 && Cols > 0);
+
+    static constexpr int rows = Rows;
+    static constexpr int cols = Cols;
+    static constexpr int stride = Cols + 2; // latimea unei linii, cu margini
+    static constexpr int cells = (Rows + 2) * stride;
+
+    // sus, stanga, jos, dreapta (aceeasi ordine ca BFS-ul din Level)
+    static constexpr std::array<int, 4> neighbours{-stride, -1, stride, 1};
+    // cei 8 vecini distrusi de bomba
+    static constexpr std::array<int, 8> ring{-stride - 1, -stride, -stride + 1, 1, stride + 1, stride, stride - 1, -1};
+
+    constexpr FixedMaze() {
+        for (int row = -1; row <= Rows; row++) {
+            for (int col = -1; col <= Cols; col++) {
+                const bool margin = row < 0 || col < 0 || row == Rows || col == Cols;
+                m_cells[index(row, col)] = margin ? Margin : Wall;
+            }
+        }
+    }
+
+    static constexpr int index(const int row, const int col) { return (row + 1) * stride + col + 1; }
+
+    constexpr void generate(const std::uint64_t seed) requires (Rows == Cols) {
+        SplitMix64 rng{seed};
+        carveSidewinder(Rows,
+                        [&rng](const int from, const int to) { return uniformInt(rng, from, to); },
+                        [this](const int row, const int col) { m_cells[index(row, col)] = Free; });
+    }
+
+    // row, col trebuie sa fie in interior; marginea ramane zid, deci nu e nevoie de verificari
+    constexpr void createHole(const int row, const int col) {
+        const int center = index(row, col);
+        for (const int offset: ring) {
+            m_cells[center + offset] &= Margin;
+        }
+    }
+
+    [[nodiscard]] constexpr bool isWall(const int row, const int col) const { return m_cells[index(row, col)] != Free; }
+
+    // walls[row * Cols + col], ca Level::wall
+    void assign(const std::vector<std::uint8_t> &walls) {
+        for (int row = 0; row < Rows; row++) {
+            for (int col = 0; col < Cols; col++) {
+                m_cells[index(row, col)] = walls[(std::size_t) row * Cols + col] ? Wall : Free;
+            }
+        }
+    }
+
+    [[nodiscard]] std::vector<std::uint8_t> walls() const {
+        std::vector<std::uint8_t> result((std::size_t) Rows * Cols);
+        for (int row = 0; row < Rows; row++) {
+            for (int col = 0; col < Cols; col++) {
+                result[(std::size_t) row * Cols + col] = isWall(row, col);
+            }
+        }
+        return result;
+    }
+
+    // ca Maze::getFreeCells: prima linie (iesirea) nu este inclusa
+    [[nodiscard]] std::vector<std::pair<int, int>> getFreeCells() const {
+        std::vector<std::pair<int, int>> result;
+        for (int row = 1; row < Rows; row++) {
+            for (int col = 0; col < Cols; col++) {
+                if (!isWall(row, col)) {
+                    result.emplace_back(row, col);
+                }
+            }
+        }
+        return result;
+    }
+
+    // BFS; rezultatul este rand cu rand, -1 pentru celulele la care nu se ajunge
+    [[nodiscard]] std::vector<std::int32_t> distancesFrom(const int row, const int col) const {
+        std::array<std::int32_t, cells> distance;
+        distance.fill(-1);
+        // fiecare celula intra cel mult o data; in plus un loc pentru scrierea de dupa ultima celula
+        std::array<int, Rows * Cols + 1> frontier;
+        int head = 0, tail = 0;
+
+        distance[index(row, col)] = 0;
+        frontier[tail++] = index(row, col);
+        while (head < tail) {
+            const int cell = frontier[head++];
+            const std::int32_t step = distance[cell] + 1;
+            for (const int offset: neighbours) {
+                // fara ramificatii: vecinul se scrie oricum in coada, dar coada creste doar daca este nou
+                const int next = cell + offset;
+                const bool discovered = (m_cells[next] == Free) & (distance[next] < 0);
+                distance[next] = discovered ? step : distance[next];
+                frontier[tail] = next;
+                tail += discovered;
+            }
+        }
+
+        std::vector<std::int32_t> result((std::size_t) Rows * Cols);
+        for (int r = 0; r < Rows; r++) {
+            for (int c = 0; c < Cols; c++) {
+                result[(std::size_t) r * Cols + c] = distance[index(r, c)];
+            }
+        }
+        return result;
+    }
+
+private:
+    // createHole pastreaza doar bitul marginii: Wall devine Free, Margin ramane Margin
+    static constexpr std::uint8_t Free = 0, Wall = 1, Margin = 2;
+
+    std::array<std::uint8_t, cells> m_cells{};
+};
+
+// Dimensiunile pentru care exista kerneluri specializate (cele din meniul jocului).
+inline constexpr int fixedMazeMinSize = 10;
+inline constexpr int fixedMazeMaxSize = 30;
+
+// Apeleaza fixed(std::integral_constant<int, dim>{}) daca dim este una dintre dimensiunile de mai sus, altfel
+// fallback(). Ambele trebuie sa intoarca acelasi tip. Exemplu:
+//
+//   dispatchMazeSize(dim, [&](auto size) { FixedMaze<size, size> maze; ... }, [&]() { Maze maze{dim}; ... });
+template<int Size = fixedMazeMinSize, typename Fixed, typename Fallback>
+decltype(auto) dispatchMazeSize(const int dim, Fixed &&fixed, Fallback &&fallback) {
+    if constexpr (Size > fixedMazeMaxSize) {
+        return fallback();
+    }
+    else {
+        if (dim == Size) {
+            return fixed(std::integral_constant<int, Size>{});
+        }
+        return dispatchMazeSize<Size + 1>(dim, std::forward<Fixed>(fixed), std::forward<Fallback>(fallback));
+    }
+}
+
+#endif //OOP_FIXEDMAZE_H
@@ -0,0 +1,116 @@
+#ifndef OOP_GAME_H
+#define OOP_GAME_H
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+#include <random.hpp>
+#include <rlutil.h>
+
+#include "DistanceField.h"
+#include "FieldOfView.h"
+#include "Level.h"
+#include "Maze.h"
+#include "Object.h"
+#include "Player.h"
+#include "Recording.h"
+#include "SplitMix64.h"
+#include "StateSync.h"
+#include "TimerWheel.h"
+
+class Game {
+public:
+    using Clock = TimerWheel::Clock;
+
+    // bomba se pune abia la start, deci constructorul nu atinge generatorul global si jocurile pe niveluri pregatite
+    // se pot crea si juca pe orice thread
+    explicit Game(const int maze_size) : m_maze(maze_size), bomb{0, maze_size - 1, rlutil::LIGHTGREEN},
+                                          m_mazeSize(maze_size), m_isRunning(true), m_toggleRender(true) {};
+
+    void run(Recording &recording); // joc interactiv; tastele procesate sunt adaugate in recording
+    void replay(const Recording &recording, bool realTime); // reia o sesiune inregistrata
+    void runLevel(const Level &level, std::chrono::seconds timeLimit); // joc interactiv pe un nivel pregatit dinainte
+
+    // API folosit de run/replay si de benchmark-uri: jocul poate fi condus tasta cu tasta, cu un ceas dat din afara
+    void start(Clock::time_point now); // genereaza labirintul, merele si timerele jocului
+    // fara generare; bombele noi sunt trase din seed-ul nivelului, nu din generatorul global
+    void start(Clock::time_point now, const Level &level, std::chrono::seconds timeLimit);
+    void step(Clock::time_point now, int key_pressed); // avanseaza timerele pana la now si proceseaza tasta
+    void advance(Clock::time_point now); // doar timerele, fara tasta (HUD, bomba, expirare)
+    void render();
+    void setRenderEnabled(bool enabled);
+    // ceata de razboi: se afiseaza doar ce vede jucatorul pana la radius celule (0 = fara ceata); se seteaza inainte
+    // de start, iar campul vizual se recalculeaza doar cand jucatorul se muta sau o bomba deschide pereti in raza lui
+    void setFogOfWar(int radius);
+    [[nodiscard]] bool isRunning() const;
+    [[nodiscard]] bool isWon() const; // toate merele culese inainte sa expire timpul
+    [[nodiscard]] Clock::time_point nextDeadline() const; // momentul urmatorului timer al jocului
+    [[nodiscard]] std::string resultMessage() const;
+
+    // cu un sink setat, render() nu mai scrie in consola ci construieste cadrele ca text ANSI si le trimite
+    // sink-ului (de exemplu catre un client conectat la server)
+    using FrameSink = std::function<void(const std::string &)>;
+    void setFrameSink(FrameSink sink);
+    void renderFrame(std::string &frame) const;
+    void syncState(SyncState &state) const; // starea trimisa spectatorilor (vezi StateSync.h)
+    [[nodiscard]] std::uint64_t stateHash() const; // hash Zobrist al starii, egal cu Zobrist::hash(syncState)
+    // distanta de la fiecare celula la cel mai apropiat mar ramas, actualizata la cules si la bomba
+    [[nodiscard]] const DistanceField &appleDistances() const;
+
+    // starea vazuta de un jucator (om sau bot), ca in Arena
+    [[nodiscard]] const Maze &getMaze() const;
+    [[nodiscard]] std::pair<int, int> playerPosition() const;
+    [[nodiscard]] bool playerHasBomb() const;
+    [[nodiscard]] const std::vector<Object> &getApples() const;
+    [[nodiscard]] bool hasApple(int row, int col) const;
+    [[nodiscard]] int applesLeft() const;
+    [[nodiscard]] int bombColumn() const; // coloana bombei de pe randul 0, -1 daca nu exista
+
+    // alege pozitiile merelor dintre celulele libere ale labirintului (regulile din ApplePlacement.h)
+    static std::vector<Object> placeApples(const std::vector<std::pair<int, int>> &freeCells);
+    // la fel, cu un generator propriu: aceleasi mere ca nivelul generat din acelasi flux (Level, bakeLevel)
+    static std::vector<Object> placeApples(const std::vector<std::pair<int, int>> &freeCells, SplitMix64 &rng);
+
+private:
+    void generate(); // bomba, labirintul si merele, din generatorul global
+    [[nodiscard]] std::chrono::seconds generatedTimeLimit() const; // din DifficultyTable::shared(), daca are randuri
+    [[nodiscard]] std::chrono::seconds legacyTimeLimit() const; // un minut la fiecare 10 mere, ca inainte de tabela
+    void begin(Clock::time_point now, std::chrono::seconds timeLimit); // timerele si hash-ul, dupa ce starea e gata
+    void play(Recording &recording);
+    void advanceTo(Clock::time_point now);
+    void handleEvent(int key_pressed, bool &renderFlag);
+    void movePlayer(int row, int col);
+    void renderHud() const; // rescrie doar linia cu timpul ramas
+    [[nodiscard]] bool isShown(int row, int col) const; // in campul vizual, daca exista ceata
+    [[nodiscard]] std::string hudText() const;
+    [[nodiscard]] std::string nearestAppleText() const; // distanta pana la cel mai apropiat mar, pentru HUD
+    void scheduleHudRefresh();
+    void showResult() const;
+
+    Maze m_maze;
+    Player m_player;
+    Object bomb;
+    std::vector<Object> objects;
+    std::optional<SplitMix64> m_levelRng; // coloanele bombelor noi pe un nivel pregatit
+    DistanceField m_appleField; // sursele sunt merele din objects
+    FieldOfView m_view; // folosit doar cu ceata de razboi
+    int m_fogRadius{};
+    std::uint64_t m_hash{}; // partea din hash care nu tine de pereti (mere, bomba, jucator), actualizata la fiecare schimbare
+    TimerWheel m_timers; // expirarea jocului, respawn-ul bombei si actualizarea HUD-ului
+    Clock::time_point gameStarted;
+    Clock::time_point m_now; // ceasul jocului; la replay este ceasul virtual al inregistrarii
+
+    std::chrono::seconds m_timeLimit{}; // timpul total alocat jocului
+    int m_mazeSize{};
+    bool m_isRunning{}; // flag pentru a mentine rularea jocului
+    bool m_toggleRender{}; // flag ca sa fac render doar atunci cand s-a intamplat ceva
+    bool m_timeExpired{};
+    bool m_renderEnabled{true}; // la replay rapid nu se afiseaza nimic
+    FrameSink m_frameSink;
+};
+
+#endif //OOP_GAME_H
@@ -0,0 +1,100 @@
+#ifndef OOP_GAMESERVER_H
+#define OOP_GAMESERVER_H
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <sys/epoll.h>
+
+#include "Broadcast.h"
+#include "Game.h"
+#include "StateSync.h"
+#include "TimerWheel.h"
+
+// Adresa serverului: "unix:/cale/socket" sau "tcp:<port>" (doar pe 127.0.0.1)
+struct Endpoint {
+    bool isUnix{};
+    std::string path;
+    int port{};
+
+    static Endpoint parse(const std::string &text);
+};
+
+int connectTo(const Endpoint &endpoint); // socket conectat (blocant) sau exceptie
+
+// Server cu multe sesiuni independente pe un singur reactor epoll. Fiecare client trimite intai dimensiunea
+// labirintului terminata cu '\n' (ca la promptul din consola), apoi aceleasi taste pe care le intelege
+// handleEvent; serverul trimite inapoi cadrele ANSI ale jocului, iar la final mesajul de rezultat, dupa care
+// inchide conexiunea. Un client care trimite in loc de dimensiune "watch <id>" devine spectator al sesiunii id
+// (numerotate de la 1, in ordinea conexiunilor) si primeste starea jocului ca mesaje DeltaEncoder, fiecare
+// precedat de lungimea lui ca varint; mesajele sunt codate o singura data pentru toti spectatorii. Timerele jocurilor (HUD, bomba, expirare) sunt puse pe un singur TimerWheel al
+// serverului, deci reactorul se trezeste doar pentru socket-uri active sau timere scadente.
+class GameServer {
+public:
+    explicit GameServer(const Endpoint &endpoint, std::size_t maxPendingBytes = 1 << 20,
+                        std::size_t maxSpectatorBytes = 64 << 10);
+    ~GameServer();
+
+    GameServer(const GameServer &) = delete;
+    GameServer &operator=(const GameServer &) = delete;
+
+    void run(); // pana la stop()
+    void stop(); // poate fi apelat din alt thread sau dintr-un signal handler
+
+    [[nodiscard]] std::size_t sessionCount() const;
+
+private:
+    using Clock = TimerWheel::Clock;
+
+    struct Session {
+        std::uint64_t id{};
+        int fd{-1};
+        std::string sizeLine; // dimensiunea labirintului (sau cererea "watch"), pana la primul '\n'
+        std::unique_ptr<Game> game;
+        std::unique_ptr<Broadcast> spectators; // creat la primul spectator al jocului
+        DeltaEncoder encoder;
+        SyncState syncState;
+        std::uint64_t watching{}; // pentru spectatori: sesiunea urmarita
+        Broadcast::Subscriber subscriber;
+        std::string outbox; // date netrimise inca
+        std::size_t sent{}; // cat din outbox a fost deja scris
+        std::size_t timerId{};
+        bool hasTimer{};
+        std::uint32_t interest{EPOLLIN}; // evenimentele epoll urmarite pentru socket
+        bool readClosed{}; // clientul a terminat de trimis
+        bool closing{}; // se inchide dupa ce outbox-ul este trimis
+        bool closed{};
+    };
+
+    void accept();
+    void onReadable(Session &session);
+    void onWritable(Session &session);
+    void startGame(Session &session, int mazeSize);
+    void watch(Session &session, std::uint64_t gameId);
+    void publishState(Session &session); // trimite spectatorilor starea curenta a jocului
+    void flushSpectator(Session &session);
+    void handleKeys(Session &session, const char *keys, std::size_t count);
+    void finishGame(Session &session);
+    void scheduleWake(Session &session);
+    void flush(Session &session);
+    void close(Session &session);
+    void updateInterest(Session &session);
+
+    Endpoint m_endpoint;
+    std::size_t m_maxPendingBytes;
+    std::size_t m_maxSpectatorBytes;
+    int m_listenFd{-1};
+    int m_epollFd{-1};
+    int m_wakeFd{-1}; // eventfd pentru stop()
+    std::atomic<bool> m_stopping{false};
+    std::uint64_t m_nextId{1};
+    std::unordered_map<std::uint64_t, std::unique_ptr<Session>> m_sessions;
+    std::vector<std::uint64_t> m_closed; // sesiuni sterse la finalul iteratiei curente
+    TimerWheel m_timers;
+};
+
+#endif //OOP_GAMESERVER_H
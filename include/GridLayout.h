@@ -0,0 +1,77 @@
+#ifndef OOP_GRIDLAYOUT_H
+#define OOP_GRIDLAYOUT_H
+
+#include <cstddef>
+#include <cstdint>
+
+// Moduri de asezare in memorie a unei grile dim x dim. Fiecare transforma (row, col) intr-un index dintr-un vector
+// de size() elemente; restul codului vede doar cellIndex(row, col), deci aceeasi logica merge cu oricare dintre ele.
+
+// rand cu rand: vecinul de sus/jos este la dim elemente distanta
+class RowMajorLayout {
+public:
+    static constexpr const char *name = "rowmajor";
+
+    explicit RowMajorLayout(const int dim) : m_dim(dim) {}
+
+    [[nodiscard]] std::size_t size() const { return (std::size_t) m_dim * m_dim; }
+    [[nodiscard]] std::size_t index(const int row, const int col) const { return (std::size_t) row * m_dim + col; }
+
+private:
+    int m_dim;
+};
+
+// blocuri de 8 x 8 celule (64 de octeti, o linie de cache), asezate rand cu rand; in interiorul blocului tot rand cu
+// rand. Un vecin vertical este de obicei in aceeasi linie de cache.
+class TiledLayout {
+public:
+    static constexpr const char *name = "tiled";
+    static constexpr int tileShift = 3;
+    static constexpr int tileMask = (1 << tileShift) - 1;
+
+    explicit TiledLayout(const int dim) : m_tilesPerRow((dim + tileMask) >> tileShift) {}
+
+    [[nodiscard]] std::size_t size() const { return (std::size_t) m_tilesPerRow * m_tilesPerRow << (2 * tileShift); }
+    [[nodiscard]] std::size_t index(const int row, const int col) const {
+        const std::size_t tile = (std::size_t) (row >> tileShift) * m_tilesPerRow + (col >> tileShift);
+        return tile << (2 * tileShift) | (std::size_t) (row & tileMask) << tileShift | (std::size_t) (col & tileMask);
+    }
+
+private:
+    int m_tilesPerRow;
+};
+
+// ordinea Z (Morton): bitii lui row si col intercalati, deci orice bloc aliniat de 2^k x 2^k este contiguu. Latura
+// se rotunjeste la o putere a lui 2, asa ca pentru dimensiuni nepotrivite se foloseste pana la de 4 ori mai multa
+// memorie.
+class MortonLayout {
+public:
+    static constexpr const char *name = "morton";
+
+    explicit MortonLayout(const int dim) {
+        while ((1 << m_bits) < dim) {
+            ++m_bits;
+        }
+    }
+
+    [[nodiscard]] std::size_t size() const { return (std::size_t) 1 << (2 * m_bits); }
+    [[nodiscard]] std::size_t index(const int row, const int col) const {
+        return (std::size_t) (spread((std::uint32_t) row) << 1 | spread((std::uint32_t) col));
+    }
+
+private:
+    // bitul i ajunge pe pozitia 2i
+    static std::uint64_t spread(const std::uint32_t value) {
+        std::uint64_t x = value;
+        x = (x | x << 16) & 0x0000FFFF0000FFFFULL;
+        x = (x | x << 8) & 0x00FF00FF00FF00FFULL;
+        x = (x | x << 4) & 0x0F0F0F0F0F0F0F0FULL;
+        x = (x | x << 2) & 0x3333333333333333ULL;
+        x = (x | x << 1) & 0x5555555555555555ULL;
+        return x;
+    }
+
+    int m_bits = 0;
+};
+
+#endif //OOP_GRIDLAYOUT_H
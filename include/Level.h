@@ -0,0 +1,42 @@
+#ifndef OOP_LEVEL_H
+#define OOP_LEVEL_H
+
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Un nivel complet determinat de (dimensiune, seed): labirintul, merele si bomba initiala, impreuna cu analiza lui.
+// Spre deosebire de Game::start, generarea foloseste doar generatorul propriu al nivelului, deci poate rula pe orice
+// thread si da acelasi nivel pe orice masina.
+struct Level {
+    static constexpr const char *generatorName = "sidewinder-2"; // se schimba odata cu algoritmul de generare
+
+    int dim{};
+    std::uint64_t seed{};
+    std::vector<std::uint8_t> wall; // dim * dim celule, rand cu rand
+    std::vector<std::pair<int, int>> apples;
+    int bombCol{};
+
+    // analiza (din analyze())
+    int components{}; // componente conexe ale celulelor libere (vecini sus/jos/stanga/dreapta)
+    std::vector<std::int32_t> distance; // pasi de la iesire (0, 0); -1 pentru celulele la care nu se ajunge fara bomba
+    int reachableApples{};
+    std::vector<std::pair<int, int>> parRoute; // merele accesibile, in ordinea traseului de referinta
+    int parLength{}; // pasii traseului de referinta, inclusiv intoarcerea la iesire
+
+    static Level generate(int dim, std::uint64_t seed); // genereaza si analizeaza
+    static Level generateLayout(int dim, std::uint64_t seed); // doar labirintul, merele si bomba, fara analyze()
+    void analyze();
+
+    [[nodiscard]] std::vector<std::uint8_t> serialize() const;
+    static bool deserialize(const std::vector<std::uint8_t> &data, Level &level); // false daca datele sunt invalide
+
+    bool operator==(const Level &) const = default;
+
+private:
+    template<typename DistancesFrom>
+    void analyzeRoute(const DistancesFrom &bfs); // distance si traseul de referinta, cu BFS-ul dat
+};
+
+#endif //OOP_LEVEL_H
@@ -0,0 +1,63 @@
+#ifndef OOP_LEVELCACHE_H
+#define OOP_LEVELCACHE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+
+#include "Level.h"
+
+// Cache pe disc pentru nivelurile generate si analizate. Cheia unui nivel este digestul BLAKE2b al
+// (generator, dimensiune, seed), iar continutul este salvat sub digestul SHA3 al octetilor lui:
+//
+//   <director>/keys/<blake2b>    contine numele obiectului
+//   <director>/objects/<sha3>    nivelul serializat (Level::serialize)
+//
+// Doua chei care produc acelasi nivel impart obiectul, iar un obiect al carui continut nu mai corespunde
+// numelui este ignorat si regenerat. In fata discului stau ultimele memoryEntries niveluri folosite (LRU: un nivel
+// cerut din nou trece la coada listei, iar cand lista e plina pleaca cel din fata), deci o cerere repetata nu mai
+// citeste nimic. Poate fi folosit din mai multe thread-uri.
+class LevelCache {
+public:
+    struct Stats {
+        std::uint64_t memoryHits{};
+        std::uint64_t diskHits{};
+        std::uint64_t generated{};
+    };
+
+    explicit LevelCache(std::filesystem::path directory, std::size_t memoryEntries = 256);
+
+    std::shared_ptr<const Level> get(int dim, std::uint64_t seed);
+
+    [[nodiscard]] static std::string key(int dim, std::uint64_t seed);
+    [[nodiscard]] Stats stats() const;
+    void clearMemory(); // doar cache-ul din memorie; util ca sa masori citirile de pe disc
+
+private:
+    [[nodiscard]] std::shared_ptr<const Level> load(const std::string &key) const;
+    void store(const std::string &key, const Level &level) const;
+    using MemoryKey = std::pair<int, std::uint64_t>; // (dimensiune, seed); digestul se calculeaza doar pentru disc
+
+    void remember(const MemoryKey &key, const std::shared_ptr<const Level> &level);
+
+    std::filesystem::path m_directory;
+    std::size_t m_memoryEntries;
+
+    struct MemoryEntry {
+        std::shared_ptr<const Level> level;
+        std::list<MemoryKey>::iterator position; // locul cheii in m_order
+    };
+
+    mutable std::mutex m_mutex;
+    std::map<MemoryKey, MemoryEntry> m_memory;
+    std::list<MemoryKey> m_order; // de la cel mai vechi folosit la cel mai recent
+    Stats m_stats;
+};
+
+#endif //OOP_LEVELCACHE_H
@@ -0,0 +1,30 @@
+#ifndef OOP_LEVELCATALOG_H
+#define OOP_LEVELCATALOG_H
+
+#include <array>
+#include <cstdint>
+
+#include "BakedLevel.h"
+
+// Niveluri fixe, coapte in binar la compilare: nu costa nimic la pornire si sunt aceleasi pe orice masina.
+// Seed-urile au fost alese astfel incat toate merele sa fie accesibile fara bomba.
+namespace LevelCatalog {
+    inline constexpr BakedLevel<10> tutorial = bakeLevel<10>(2);
+
+    // cate un nivel pentru fiecare zi a saptamanii, de duminica (0) pana sambata (6)
+    inline constexpr std::array<BakedLevel<20>, 7> daily =
+            bakeLevels<20>(std::array<std::uint64_t, 7>{2026, 2027, 2028, 2029, 2032, 2033, 2038});
+
+    // Fixture-uri: amprentele peretilor si numarul de mere. Daca generarea se schimba (Sidewinder, uniformInt,
+    // plasarea merelor), compilarea se opreste aici; atunci trebuie schimbat si Level::generatorName.
+    static_assert(tutorial.wallHash() == 0xba2d740fdbfaa8e3ULL && tutorial.appleCount == 6);
+    static_assert(daily[0].wallHash() == 0x7c3ff0323e91880dULL && daily[0].appleCount == 6);
+    static_assert(daily[1].wallHash() == 0x92b584aebdd5479bULL && daily[1].appleCount == 14);
+    static_assert(daily[2].wallHash() == 0x97986dfea13d8c67ULL && daily[2].appleCount == 51);
+    static_assert(daily[3].wallHash() == 0xa2a1b015386d5d92ULL && daily[3].appleCount == 12);
+    static_assert(daily[4].wallHash() == 0xa8c74444f4eef285ULL && daily[4].appleCount == 44);
+    static_assert(daily[5].wallHash() == 0xc292f11012d6f107ULL && daily[5].appleCount == 9);
+    static_assert(daily[6].wallHash() == 0xff25a886b2a6a07dULL && daily[6].appleCount == 52);
+}
+
+#endif //OOP_LEVELCATALOG_H
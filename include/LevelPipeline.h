@@ -0,0 +1,83 @@
+#ifndef OOP_LEVELPIPELINE_H
+#define OOP_LEVELPIPELINE_H
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <map>
+#include <memory>
+#include <mutex>
+
+#include "Level.h"
+#include "LevelCache.h"
+#include "ThreadPool.h"
+
+// Un nivel gata de jucat: labirintul cu merele deja plasate si timpul acordat.
+struct PreparedLevel {
+    std::shared_ptr<const Level> level;
+    std::chrono::seconds timeLimit{};
+};
+
+// Pregateste in fundal urmatoarele niveluri ale unei campanii: generare -> validare (toate merele accesibile fara
+// bomba, altfel se incearca alt seed) -> plasarea merelor -> timpul de referinta. Cel mult depth niveluri sunt in
+// lucru sau asteapta sa fie jucate, iar next() le da in ordine, deci trecerea la nivelul urmator nu mai genereaza
+// nimic pe thread-ul jocului. Nivelul i depinde doar de (dim, seed, i), indiferent de ordinea in care se termina
+// task-urile.
+//
+// Daca niciunul din cele maxAttempts seed-uri nu da un nivel jucabil, next() arunca std::runtime_error in loc sa
+// dea un nivel care nu poate fi castigat. O eroare a cache-ului (disc plin, director sters) nu opreste nimic:
+// nivelul se genereaza atunci direct.
+class LevelPipeline {
+public:
+    // cache poate lipsi; daca exista, trebuie sa traiasca mai mult decat pipeline-ul
+    LevelPipeline(int dim, std::uint64_t seed, std::size_t depth = 4, LevelCache *cache = nullptr);
+    ~LevelPipeline(); // asteapta task-urile pornite
+
+    LevelPipeline(const LevelPipeline &) = delete;
+    LevelPipeline &operator=(const LevelPipeline &) = delete;
+
+    PreparedLevel next(); // blocheaza doar daca nivelul urmator nu e inca gata; arunca eroarea task-ului lui
+
+    [[nodiscard]] std::size_t ready() const; // niveluri terminate care asteapta next()
+    [[nodiscard]] std::uint64_t levelIndex() const; // indexul nivelului dat de urmatorul next()
+
+    static std::chrono::seconds timeLimit(const Level &level); // din DifficultyTable::shared()
+
+    // regulile dupa care se aleg nivelurile, folosite si de calibrare: nivelul index incearca pe rand seed-urile
+    // levelSeed(seed, index, 0..maxAttempts-1) pana la primul jucabil (cel putin 5 mere, toate accesibile fara bomba)
+    static constexpr int maxAttempts = 16;
+    static std::uint64_t levelSeed(std::uint64_t seed, std::uint64_t index, int attempt);
+    static bool isPlayable(const Level &level);
+
+private:
+    // rezultatul unui task: nivelul sau exceptia lui, aruncata mai departe de next() pe thread-ul jocului
+    struct Result {
+        PreparedLevel prepared;
+        std::exception_ptr error;
+    };
+
+    void refill(); // apelat cu m_mutex blocat
+    [[nodiscard]] PreparedLevel prepare(std::uint64_t index) const; // arunca daca nu gaseste un nivel jucabil
+    [[nodiscard]] std::shared_ptr<const Level> load(std::uint64_t seed) const; // din cache daca se poate
+
+    int m_dim;
+    std::uint64_t m_seed;
+    std::size_t m_depth;
+    LevelCache *m_cache;
+
+    // pe o masina cu un singur core pool-ul comun nu are workeri si ar genera pe thread-ul apelant, asa ca
+    // pipeline-ul are atunci propriul worker, cu prioritate minima
+    std::unique_ptr<ThreadPool> m_ownPool;
+    ThreadPool *m_pool;
+
+    mutable std::mutex m_mutex;
+    std::condition_variable m_changed;
+    std::map<std::uint64_t, Result> m_ready;
+    std::uint64_t m_next = 0; // urmatorul nivel dat de next()
+    std::uint64_t m_issued = 0; // urmatorul nivel care va fi pornit
+    std::size_t m_inFlight = 0;
+};
+
+#endif //OOP_LEVELPIPELINE_H
@@ -0,0 +1,63 @@
+#ifndef OOP_MAZE_H
+#define OOP_MAZE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <utility>
+#include <vector>
+
+#include "GridLayout.h"
+
+// Labirintul jocului. Layout alege cum stau celulele in memorie (vezi GridLayout.h); API-ul este acelasi pentru
+// toate, iar jocul foloseste Maze, adica asezarea rand cu rand. Instantierile existente sunt cele din Maze.cpp.
+template<typename Layout>
+class BasicMaze {
+public:
+    explicit BasicMaze(const int dim) : m_layout(dim), m_maze(m_layout.size(), '#'), m_dim(dim) { m_hash = computeHash(); };
+
+    friend std::ostream &operator<<(std::ostream &out, const BasicMaze &maze) {
+        maze.print(out);
+        return out;
+    }
+
+    bool isPositionAvailable(const int row, const int col) { // verifica daca o noua pozitie este buna
+        return isInside(row, col) && m_maze[m_layout.index(row, col)] != '#';
+    }
+    void generate(); // genereaza un labirint
+    void generate(std::uint64_t seed); // la fel, dar cu un generator propriu; poate rula pe orice thread
+    void assign(const std::vector<std::uint8_t> &wall); // dim * dim celule, rand cu rand (de exemplu Level::wall)
+    void createHole(int row, int col); // distruge cei 8 vecini din jurul jucatorului cand a folosit bomba
+
+    std::vector<std::pair<int, int>> getFreeCells(); // cauta toate locurile libere din labirint
+
+    // false si pentru pozitii din afara labirintului
+    [[nodiscard]] bool isWall(const int row, const int col) const {
+        return isInside(row, col) && m_maze[m_layout.index(row, col)] == '#';
+    }
+    [[nodiscard]] int getSize() const;
+
+    // pentru algoritmii care tin date pe celula (distante, vizitat) in acelasi layout ca labirintul
+    [[nodiscard]] std::size_t cellIndex(const int row, const int col) const { return m_layout.index(row, col); }
+    [[nodiscard]] std::size_t cellCount() const { return m_maze.size(); }
+
+    [[nodiscard]] std::uint64_t getHash() const; // hash Zobrist al peretilor, actualizat de createHole
+    [[nodiscard]] std::uint64_t computeHash() const; // acelasi hash, recalculat din tot labirintul
+
+private:
+    [[nodiscard]] bool isInside(const int row, const int col) const { // verifica daca coordonatele sunt in interiorul labirintului
+        return row >= 0 && col >= 0 && row < m_dim && col < m_dim;
+    }
+    void print(std::ostream &out) const;
+
+    Layout m_layout;
+    std::vector<char> m_maze; // labirintul, in ordinea data de m_layout
+    int m_dim{}; // dimensiunea labirintului
+    std::uint64_t m_hash{};
+};
+
+using Maze = BasicMaze<RowMajorLayout>;
+using TiledMaze = BasicMaze<TiledLayout>;
+using MortonMaze = BasicMaze<MortonLayout>;
+
+#endif //OOP_MAZE_H
@@ -0,0 +1,86 @@
+#ifndef OOP_MAZEANALYTICS_H
+#define OOP_MAZEANALYTICS_H
+
+#include <array>
+#include <cstdint>
+#include <iosfwd>
+#include <vector>
+
+#include "Level.h"
+#include "ThreadPool.h"
+
+// Metricile de calitate ale labirinturilor generate, adunate peste multe labirinte. Fiecare camp este o suma, deci
+// doua rezultate partiale se combina cu += (reductia paralela), iar mediile se calculeaza abia la afisare.
+//
+// Un labirint se analizeaza cu o singura trecere peste celule (gradul fiecarei celule libere si coridoarele drepte,
+// orizontale si verticale) si un BFS din iesire (solutia si merele la care nu se ajunge fara bomba).
+struct MazeMetrics {
+    // coridoare drepte de cel putin 2 celule, pe lungimi: 2, 3-4, 5-8, 9-16, 17-32, 33+
+    static constexpr int corridorBuckets = 6;
+
+    std::uint64_t mazes{};
+    std::uint64_t cells{};
+    std::uint64_t freeCells{};
+    std::uint64_t deadEnds{}; // celule libere cu un singur vecin liber
+    std::uint64_t junctions{}; // celule libere cu cel putin 3 vecini liberi
+    std::uint64_t junctionExits{}; // suma (vecini - 1) peste intersectii: cate drumuri noi se deschid
+    std::uint64_t horizontalLinks{}; // perechi de celule libere alaturate pe orizontala
+    std::uint64_t verticalLinks{};
+    std::uint64_t topRowFree{}; // celule libere pe randul 0
+    std::array<std::uint64_t, corridorBuckets> horizontalCorridors{};
+    std::array<std::uint64_t, corridorBuckets> verticalCorridors{};
+    std::uint64_t horizontalCorridorCells{};
+    std::uint64_t verticalCorridorCells{};
+    std::uint64_t solved{}; // labirinte in care tinta (ca la BigMaze: ultima celula libera de pe ultimul rand) se atinge
+    std::uint64_t solutionSteps{}; // suma lungimilor solutiilor, peste labirintele rezolvate
+    std::uint64_t unreachableCells{}; // celule libere la care nu se ajunge din iesire fara bomba
+    std::uint64_t apples{};
+    std::uint64_t applesNeedingBomb{};
+    std::uint64_t levelsNeedingBomb{};
+
+    MazeMetrics &operator+=(const MazeMetrics &other);
+};
+
+// Analiza unui labirint; bufferele se refolosesc de la un labirint la altul, deci e nevoie de cate unul pe thread.
+class MazeAnalyzer {
+public:
+    [[nodiscard]] MazeMetrics analyze(const Level &level); // level nu trebuie sa fie analizat (Level::generateLayout)
+
+private:
+    void assign(const Level &level); // peretii, cu o bordura de ziduri
+    void scanCells(MazeMetrics &metrics); // trecerea peste celule
+    void searchFromExit(const Level &level, MazeMetrics &metrics); // BFS-ul
+
+    int m_dim{};
+    int m_stride{};
+    std::vector<std::uint8_t> m_open;
+    std::vector<std::int32_t> m_distance;
+    std::vector<std::int32_t> m_queue;
+    std::vector<std::int32_t> m_verticalRun; // lungimea coridorului vertical deschis in fiecare coloana
+    std::vector<std::int32_t> m_corridorEnds; // lungimile coridoarelor terminate pe randul curent
+};
+
+struct AnalyticsConfig {
+    std::vector<int> sizes{10, 20, 30};
+    std::uint64_t firstSeed = 0; // nivelurile Level::generateLayout(size, firstSeed ... firstSeed + mazes - 1)
+    std::uint64_t mazes = 100000; // pe dimensiune
+};
+
+struct AnalyticsRow {
+    int size{};
+    MazeMetrics metrics;
+};
+
+struct AnalyticsResult {
+    std::vector<AnalyticsRow> rows;
+    double seconds{};
+};
+
+// genereaza si analizeaza labirintele pe thread pool; rezultatul nu depinde de numarul de thread-uri. Arunca
+// std::invalid_argument pentru dimensiuni sub 10 sau zero labirinte.
+AnalyticsResult analyzeMazes(const AnalyticsConfig &config, ThreadPool &pool = ThreadPool::shared());
+
+// un rand pe dimensiune, cu generatorul (Level::generatorName), intervalul de seed-uri si mediile pe labirint
+void writeAnalyticsCsv(std::ostream &out, const AnalyticsConfig &config, const AnalyticsResult &result);
+
+#endif //OOP_MAZEANALYTICS_H
@@ -0,0 +1,34 @@
+#ifndef OOP_NETCLIENT_H
+#define OOP_NETCLIENT_H
+
+#include <cstdint>
+
+#include "GameServer.h"
+
+// client interactiv: trimite tastele din consola la server si afiseaza cadrele primite
+void runInteractiveClient(const Endpoint &endpoint, int mazeSize);
+
+// spectator: urmareste sesiunea gameId si afiseaza starea reconstruita din mesajele serverului
+void runSpectator(const Endpoint &endpoint, std::uint64_t gameId);
+
+struct LoadTestResult {
+    int sessions{};
+    int completed{}; // sesiuni incheiate normal de server
+    std::uint64_t keysSent{};
+    std::uint64_t bytesReceived{};
+    int spectators{};
+    int spectatorsStarted{}; // spectatori care aveau un keyframe inainte de prima tasta; restul nu au primit nimic
+    std::uint64_t spectatorBytes{};
+    std::uint64_t spectatorMessages{}; // mesaje aplicate cu succes de decodorii spectatorilor
+    std::uint64_t spectatorDesyncs{}; // mesaje respinse pentru ca starea reconstruita avea alt hash decat serverul
+    double seconds{};
+};
+
+// client de test: deschide `sessions` conexiuni simultane, trimite fiecareia keysPerSession taste aleatoare
+// (cate una pe runda, ca un jucator), apoi 'q', si citeste tot ce trimite serverul pana la inchidere.
+// Spectatorii urmaresc sesiunile 1..sessions, deci serverul trebuie sa fie pornit proaspat; tastele se trimit dupa ce
+// fiecare spectator a primit primul keyframe sau dupa 5 secunde.
+LoadTestResult runLoadTest(const Endpoint &endpoint, int sessions, int keysPerSession, int mazeSize, std::uint64_t seed,
+                           int spectatorsPerSession = 0);
+
+#endif //OOP_NETCLIENT_H
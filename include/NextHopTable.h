@@ -0,0 +1,58 @@
+#ifndef OOP_NEXTHOPTABLE_H
+#define OOP_NEXTHOPTABLE_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "Maze.h"
+#include "ThreadPool.h"
+
+// Tabela de rutare intre toate perechile de celule libere ale unui labirint mic: pentru fiecare (sursa, tinta)
+// directia primului pas pe un drum minim, pe 2 biti. Un rand al tabelei este o tinta si se construieste cu un BFS
+// pornit din ea, deci randurile sunt independente si se impart pe thread pool. La 30 x 30 (cel mult 900 de celule
+// libere) tabela are sub 200 KB si "in ce parte o iau spre X" devine o singura citire.
+//
+// Botii au nevoie doar de cateva tinte (merele si iesirea), asa ca tabela se poate construi si doar pentru ele: un rand
+// pe tinta, iar direction() spre o celula care nu este tinta intoarce None.
+//
+// Tabela descrie labirintul din momentul construirii; dupa Maze::createHole trebuie reconstruita.
+class NextHopTable {
+public:
+    enum class Direction : std::uint8_t { Up, Left, Down, Right, None }; // None: aceeasi celula, zid sau fara drum
+
+    static constexpr int maxCells = 4096; // 4 MB de tabela
+
+    NextHopTable() = default;
+    explicit NextHopTable(const Maze &maze, ThreadPool &pool = ThreadPool::shared()); // arunca peste maxCells
+    // doar randurile tintelor date; zidurile si tintele repetate se ignora, iar maxCells nu se aplica
+    NextHopTable(const Maze &maze, const std::vector<std::pair<int, int>> &targets,
+                 ThreadPool &pool = ThreadPool::shared());
+
+    [[nodiscard]] Direction direction(int fromRow, int fromCol, int toRow, int toCol) const;
+    [[nodiscard]] std::pair<int, int> nextStep(int fromRow, int fromCol, int toRow, int toCol) const; // from daca None
+    [[nodiscard]] bool isReachable(int fromRow, int fromCol, int toRow, int toCol) const;
+
+    [[nodiscard]] static char key(Direction direction); // tasta din Game (w/a/s/d), 0 pentru None
+    [[nodiscard]] int freeCells() const;
+    [[nodiscard]] std::size_t tableBytes() const;
+
+private:
+    void indexCells(const Maze &maze); // celulele libere, vecinii si componentele
+    void buildRows(const std::vector<std::int32_t> &targets, ThreadPool &pool);
+    [[nodiscard]] std::int32_t freeIndex(int row, int col) const; // -1 pentru ziduri si in afara labirintului
+    void buildRow(std::size_t slot, std::int32_t target, std::vector<std::int32_t> &queue, std::vector<std::uint8_t> &seen);
+
+    int m_dim{};
+    std::vector<std::int32_t> m_index; // celula (rand cu rand) -> indexul ei printre celulele libere, -1 la ziduri
+    std::vector<std::int32_t> m_cell; // invers: indexul celulei libere -> celula
+    std::vector<std::array<std::int32_t, 4>> m_neighbours; // vecinii liberi (sus, stanga, jos, dreapta), -1 daca lipsesc
+    std::vector<std::int32_t> m_component; // componenta conexa a fiecarei celule libere
+    std::vector<std::int32_t> m_rowOf; // celula libera -> randul ei din tabela, -1 daca nu este tinta
+    std::size_t m_rowBytes{}; // 4 directii pe octet, randurile aliniate la octet ca thread-urile sa nu se atinga
+    std::vector<std::uint8_t> m_table;
+};
+
+#endif //OOP_NEXTHOPTABLE_H
@@ -0,0 +1,26 @@
+#ifndef OOP_OBJECT_H
+#define OOP_OBJECT_H
+
+#include <iostream>
+#include <utility>
+#include <rlutil.h>
+
+class Object {
+public:
+    Object(const int row, const int col, const int color = rlutil::LIGHTRED) : m_crtRow(row), m_crtCol(col), m_color(color) {};
+    Object(const Object& obj) : m_crtRow(obj.m_crtRow), m_crtCol(obj.m_crtCol), m_color(obj.m_color) {} // NOLINT(*-use-equals-default)
+    // cc-ul de sus trebuie declarat cu = default
+    ~Object(); // destr
+
+    Object& operator=(const Object &obj); // operator=
+    friend std::ostream &operator<<(std::ostream &out, const Object &object);
+
+    [[nodiscard]] std::pair<int, int> getPosition() const;
+    [[nodiscard]] int getColor() const;
+
+private:
+    int m_crtRow, m_crtCol; // coordonatele obiectului
+    int m_color; // culoarea obiectului
+};
+
+#endif //OOP_OBJECT_H
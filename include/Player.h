@@ -0,0 +1,27 @@
+#ifndef OOP_PLAYER_H
+#define OOP_PLAYER_H
+
+#include <iostream>
+#include <utility>
+
+class Player {
+public:
+    Player() : m_crtRow(0), m_crtCol(0), m_hasBomb(false) {};
+
+    [[maybe_unused]] Player(const Player &player);
+    ~Player();
+
+    Player& operator=(std::pair<int, int> pos); // op=
+    friend std::ostream &operator<<(std::ostream &out, const Player &player);
+
+
+    void setHasBomb(bool val);
+    [[nodiscard]] bool getHasBomb() const;
+    [[nodiscard]] std::pair<int, int> getPosition() const;
+
+private:
+    int m_crtRow, m_crtCol; // pozitia curenta a jucatorului
+    bool m_hasBomb;
+};
+
+#endif //OOP_PLAYER_H
@@ -0,0 +1,98 @@
+#ifndef OOP_PNMEXPORT_H
+#define OOP_PNMEXPORT_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <queue>
+#include <utility>
+#include <vector>
+
+// Export in formatele binare Netpbm, pentru labirinturi prea mari pentru consola: PBM (P4, 1 bit pe pixel, zidurile
+// negre) si PGM (P5, 8 biti pe pixel) pentru hartile de distante. Imaginea se scrie rand cu rand, deci in memorie
+// sta un singur rand, oricat de mare ar fi labirintul.
+class PnmWriter {
+public:
+    enum class Format { Bitmap, Graymap };
+
+    PnmWriter(std::ostream &out, int width, int height, Format format); // scrie antetul
+
+    // width pixeli: pentru Bitmap 1 = negru, pentru Graymap 0 (negru) .. 255 (alb); arunca dupa ultimul rand
+    void writeRow(const std::uint8_t *pixels);
+
+    [[nodiscard]] int rowsLeft() const;
+
+private:
+    std::ostream &m_out;
+    int m_width;
+    int m_rowsLeft;
+    Format m_format;
+    std::vector<char> m_row; // randul codat
+};
+
+// Tonul unei celule in harta de distante: zidurile sunt negre, celulele libere merg de la alb (la sursa) la gri inchis
+// (cea mai departata), iar cele la care nu se ajunge sunt aproape negre.
+namespace Heatmap {
+    inline constexpr std::uint8_t wall = 0;
+    inline constexpr std::uint8_t unreachable = 16;
+
+    [[nodiscard]] std::uint8_t shade(std::uint64_t distance, std::uint64_t maxDistance);
+}
+
+// PBM cu zidurile unui labirint cu API-ul lui Maze (Maze, TiledMaze, CompressedMaze...)
+template<typename MazeLike>
+void writeMazePbm(std::ostream &out, const MazeLike &maze) {
+    const int dim = maze.getSize();
+    PnmWriter writer{out, dim, dim, PnmWriter::Format::Bitmap};
+    std::vector<std::uint8_t> row((std::size_t) dim);
+    for (int r = 0; r < dim; r++) {
+        for (int c = 0; c < dim; c++) {
+            row[c] = maze.isWall(r, c);
+        }
+        writer.writeRow(row.data());
+    }
+}
+
+// distantele BFS de la (row, col), indexate cu maze.cellIndex; -1 unde nu se ajunge, ca Level::distance
+template<typename MazeLike>
+std::vector<std::int32_t> bfsDistances(const MazeLike &maze, const int row, const int col) {
+    const int dim = maze.getSize();
+    std::vector<std::int32_t> distance(maze.cellCount(), -1);
+    std::queue<std::pair<int, int>> frontier;
+    distance[maze.cellIndex(row, col)] = 0;
+    frontier.emplace(row, col);
+    while (!frontier.empty()) {
+        const auto [r, c] = frontier.front();
+        frontier.pop();
+        const std::int32_t next = distance[maze.cellIndex(r, c)] + 1;
+        const int neighbours[4][2] = {{r - 1, c}, {r, c - 1}, {r + 1, c}, {r, c + 1}};
+        for (const auto &[nr, nc]: neighbours) {
+            if (nr >= 0 && nc >= 0 && nr < dim && nc < dim && !maze.isWall(nr, nc) &&
+                distance[maze.cellIndex(nr, nc)] < 0) {
+                distance[maze.cellIndex(nr, nc)] = next;
+                frontier.emplace(nr, nc);
+            }
+        }
+    }
+    return distance;
+}
+
+// PGM cu harta distantelor (de exemplu din bfsDistances), in tonurile din Heatmap
+template<typename MazeLike>
+void writeHeatmapPgm(std::ostream &out, const MazeLike &maze, const std::vector<std::int32_t> &distance) {
+    const int dim = maze.getSize();
+    const std::int32_t maxDistance = std::max<std::int32_t>(0, *std::max_element(distance.begin(), distance.end()));
+    PnmWriter writer{out, dim, dim, PnmWriter::Format::Graymap};
+    std::vector<std::uint8_t> row((std::size_t) dim);
+    for (int r = 0; r < dim; r++) {
+        for (int c = 0; c < dim; c++) {
+            const std::int32_t d = distance[maze.cellIndex(r, c)];
+            row[c] = maze.isWall(r, c) ? Heatmap::wall
+                   : d < 0 ? Heatmap::unreachable : Heatmap::shade((std::uint64_t) d, (std::uint64_t) maxDistance);
+        }
+        writer.writeRow(row.data());
+    }
+}
+
+#endif //OOP_PNMEXPORT_H
@@ -0,0 +1,50 @@
+#ifndef OOP_RECORDING_H
+#define OOP_RECORDING_H
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// O sesiune de joc: seed-ul generatorului, dimensiunea labirintului si tastele apasate, fiecare cu momentul
+// (in ms de la inceputul jocului) la care a fost procesata. Cu acelasi seed si aceleasi momente jocul se
+// reproduce identic, pentru ca singurele surse de nedeterminism sunt RNG-ul si ceasul.
+class Recording {
+public:
+    struct Event {
+        std::uint64_t timeMs;
+        char key;
+    };
+
+    // dimensiunile din meniul jocului; load respinge fisierele cu alta dimensiune
+    static constexpr int minMazeSize = 10;
+    static constexpr int maxMazeSize = 30;
+
+    Recording() = default;
+    Recording(std::uint32_t seed, int mazeSize) : m_seed(seed), m_mazeSize(mazeSize) {}
+
+    void addEvent(std::uint64_t timeMs, char key);
+    void setEndTime(std::uint64_t timeMs);
+    void setTimeLimit(std::chrono::seconds timeLimit);
+
+    void save(const std::string &path) const;
+    static Recording load(const std::string &path); // arunca std::runtime_error pentru un fisier invalid
+
+    [[nodiscard]] std::uint32_t getSeed() const;
+    [[nodiscard]] int getMazeSize() const;
+    [[nodiscard]] const std::vector<Event> &getEvents() const;
+    [[nodiscard]] std::uint64_t getEndTime() const;
+    [[nodiscard]] std::chrono::seconds getTimeLimit() const; // 0 la inregistrarile din versiunea 1
+
+private:
+    static constexpr char magic[4] = {'N', 'I', 'T', 'M'};
+    static constexpr std::uint8_t version = 2; // versiunea 1 nu avea timpul acordat
+
+    std::uint32_t m_seed{};
+    int m_mazeSize{};
+    std::vector<Event> m_events;
+    std::uint64_t m_endTimeMs{};
+    std::chrono::seconds m_timeLimit{};
+};
+
+#endif //OOP_RECORDING_H
@@ -0,0 +1,36 @@
+#ifndef OOP_SIDEWINDER_H
+#define OOP_SIDEWINDER_H
+
+// https://weblog.jamisbuck.org/2011/2/3/maze-generation-sidewinder-algorithm
+// Algoritmul Sidewinder scris independent de modul in care este stocat labirintul: carve(row, col) marcheaza
+// celula ca libera, iar randInt(a, b) intoarce un numar aleator din [a, b]. Aceeasi secventa de numere aleatoare
+// produce acelasi labirint, oricine l-ar stoca.
+template<typename RandInt, typename Carve>
+constexpr void carveSidewinder(const int dim, RandInt &&randInt, Carve &&carve) {
+    for (int col = 0; col < dim; col++) {
+        carve(0, col);
+    }
+    for (int row = 2; row < dim; row += 2) {
+        int runStart = 1; // run-ul curent sunt celulele (row, runStart..col)
+        for (int col = 1; col < dim; col++) {
+            carve(row, col);
+
+            const bool carve_east = randInt(0, 100) > 30; // daca continui sa sap la dreapta
+
+            if (carve_east && col + 1 < dim) {
+                carve(row, col + 1);
+            }
+            else { // sap in sus dintr-o celula aleasa aleator din run
+                const int upCol = runStart + randInt(0, col - runStart);
+                carve(row - 1, upCol);
+                if (row + 1 < dim) {
+                    carve(row + 1, upCol);
+                }
+                ++col;
+                runStart = col + 1;
+            }
+        }
+    }
+}
+
+#endif //OOP_SIDEWINDER_H
@@ -0,0 +1,43 @@
+#ifndef OOP_SPLITMIX64_H
+#define OOP_SPLITMIX64_H
+
+#include <cstdint>
+#include <limits>
+
+// Generator SplitMix64: 8 octeti de stare (fata de ~5 KB pentru std::mt19937), deci potrivit cand fiecare
+// instanta dintr-un numar mare de jocuri are nevoie de propriul generator. Respecta UniformRandomBitGenerator,
+// asa ca poate fi folosit cu distributiile din <random>.
+class SplitMix64 {
+public:
+    using result_type = std::uint64_t;
+
+    constexpr explicit SplitMix64(const std::uint64_t seed = 0) : m_state(seed) {}
+
+    constexpr result_type operator()() {
+        std::uint64_t z = (m_state += 0x9E3779B97F4A7C15ULL);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        return z ^ (z >> 31);
+    }
+
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+
+private:
+    std::uint64_t m_state;
+};
+
+// Numar uniform din [from, to], prin respingere (fara bias). Spre deosebire de std::uniform_int_distribution, al
+// carei algoritm depinde de biblioteca standard, rezultatul este acelasi pe orice platforma si se poate calcula si
+// la compilare; generarea labirinturilor din seed il foloseste ca nivelurile coapte sa fie identice cu cele de la rulare.
+constexpr int uniformInt(SplitMix64 &rng, const int from, const int to) {
+    const std::uint64_t range = (std::uint64_t) ((std::int64_t) to - from) + 1;
+    const std::uint64_t threshold = (0 - range) % range; // sub el, x % range ar favoriza valorile mici
+    std::uint64_t x = rng();
+    while (x < threshold) {
+        x = rng();
+    }
+    return (int) ((std::int64_t) from + (std::int64_t) (x % range));
+}
+
+#endif //OOP_SPLITMIX64_H
@@ -0,0 +1,55 @@
+#ifndef OOP_SPSCQUEUE_H
+#define OOP_SPSCQUEUE_H
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+
+// Coada circulara fara lock-uri pentru exact un producator si un consumator. Fiecare index este scris
+// de un singur thread, asa ca ajung load/store cu acquire/release; cei doi indecsi stau pe linii de
+// cache diferite ca producatorul si consumatorul sa nu si-o dispute.
+template<typename T, std::size_t Capacity>
+class SpscQueue {
+    static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+
+public:
+    bool tryPush(const T &value) { // doar producatorul; false daca e plina
+        const std::size_t tail = m_tail.load(std::memory_order_relaxed);
+        if (tail - m_cachedHead == Capacity) {
+            m_cachedHead = m_head.load(std::memory_order_acquire);
+            if (tail - m_cachedHead == Capacity) {
+                return false;
+            }
+        }
+        m_buffer[tail & (Capacity - 1)] = value;
+        m_tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool tryPop(T &value) { // doar consumatorul; false daca e goala
+        const std::size_t head = m_head.load(std::memory_order_relaxed);
+        if (head == m_cachedTail) {
+            m_cachedTail = m_tail.load(std::memory_order_acquire);
+            if (head == m_cachedTail) {
+                return false;
+            }
+        }
+        value = m_buffer[head & (Capacity - 1)];
+        m_head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    [[nodiscard]] std::size_t sizeApprox() const {
+        return m_tail.load(std::memory_order_acquire) - m_head.load(std::memory_order_acquire);
+    }
+
+private:
+    // fiecare capat tine o copie locala a indexului celuilalt si il reciteste doar cand pare plin/gol
+    alignas(64) std::atomic<std::size_t> m_head{0};
+    std::size_t m_cachedTail{0};
+    alignas(64) std::atomic<std::size_t> m_tail{0};
+    std::size_t m_cachedHead{0};
+    alignas(64) std::array<T, Capacity> m_buffer{};
+};
+
+#endif //OOP_SPSCQUEUE_H
@@ -0,0 +1,79 @@
+#ifndef OOP_STATESYNC_H
+#define OOP_STATESYNC_H
+
+#include <cstdint>
+#include <vector>
+
+// Starea vizibila a unui joc (Game sau Arena), asa cum o vede un spectator.
+struct SyncState {
+    struct PlayerState {
+        int row{}, col{};
+        bool hasBomb{};
+        int score{}; // mere culese; in Game ramane 0
+
+        bool operator==(const PlayerState &) const = default;
+    };
+
+    int dim{};
+    std::vector<std::uint8_t> wall; // dim * dim celule, rand cu rand
+    std::vector<std::uint8_t> apple;
+    std::vector<PlayerState> players;
+    int bombCol{-1}; // coloana bombei de pe randul 0, -1 daca nu exista
+    std::uint64_t hash{}; // Zobrist::hash al starii, pus de Game/Arena::syncState din hash-ul lor incremental
+
+    bool operator==(const SyncState &) const = default;
+};
+
+// Codeaza starile succesive ale unui joc ca mesaje compacte. Un keyframe contine toata starea (peretii si
+// merele ca bitset), un delta doar ce s-a schimbat fata de mesajul anterior:
+//   - celulele ale caror pereti/mere s-au schimbat, ca indecsi crescatori codati prin diferente varint;
+//   - coloana bombei;
+//   - jucatorii modificati: diferenta de id, apoi un octet cu directia pasului (sau pozitie absoluta),
+//     bomba din mana si un bit pentru scor nou.
+// Fiecare mesaj are un numar de secventa; un delta se aplica doar peste mesajul cu secventa precedenta. Dupa secventa
+// urmeaza hash-ul Zobrist al starii (8 octeti), pe care decodorul il compara cu hash-ul starii reconstruite.
+class DeltaEncoder {
+public:
+    explicit DeltaEncoder(int keyframeInterval = 128);
+
+    // adauga la out mesajul pentru state si intoarce true; daca nu s-a schimbat nimic si nu e timpul
+    // pentru un keyframe nu scrie nimic si intoarce false
+    bool encode(const SyncState &state, std::vector<std::uint8_t> &out);
+    void requestKeyframe(); // urmatorul mesaj va fi keyframe (de exemplu pentru un spectator nou)
+
+    [[nodiscard]] std::uint64_t sequence() const; // secventa ultimului mesaj scris
+    [[nodiscard]] bool lastWasKeyframe() const;
+
+private:
+    void writeKeyframe(const SyncState &state, std::vector<std::uint8_t> &out) const;
+    void writeDelta(const SyncState &state, std::vector<std::uint8_t> &out) const;
+
+    int m_keyframeInterval;
+    int m_sinceKeyframe{};
+    bool m_forceKeyframe{true};
+    bool m_lastWasKeyframe{};
+    std::uint64_t m_sequence{};
+    SyncState m_previous;
+};
+
+// Reconstruieste starea pe partea clientului din mesajele DeltaEncoder.
+class DeltaDecoder {
+public:
+    // false, cu starea neschimbata, daca mesajul e corupt (si un jucator in afara [0, dim)), este un delta care nu
+    // continua starea curenta sau starea reconstruita nu are hash-ul trimis de server (desincronizare); clientul
+    // asteapta atunci urmatorul keyframe
+    bool apply(const std::vector<std::uint8_t> &message);
+
+    [[nodiscard]] bool hasState() const;
+    [[nodiscard]] const SyncState &state() const;
+    [[nodiscard]] std::uint64_t sequence() const;
+    [[nodiscard]] std::uint64_t desyncs() const; // respinse pentru hash gresit sau un pas care iese din labirint
+
+private:
+    SyncState m_state;
+    std::uint64_t m_sequence{};
+    std::uint64_t m_desyncs{};
+    bool m_hasState{};
+};
+
+#endif //OOP_STATESYNC_H
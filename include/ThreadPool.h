@@ -0,0 +1,163 @@
+#ifndef OOP_THREADPOOL_H
+#define OOP_THREADPOOL_H
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+// Planificator cu work stealing: fiecare worker are propria coada, din care ia task-uri de la capat (LIFO, cache
+// cald), iar cand ramane fara ia de la inceputul cozilor celorlalti (FIFO, adica bucatile mari de lucru).
+// Thread-ul care asteapta un parallelFor executa si el task-uri, deci apelurile imbricate nu se blocheaza si
+// un pool fara workeri ruleaza totul pe thread-ul apelant.
+//
+// O exceptie aruncata de fn intr-un parallelFor (sau de map intr-un parallelReduce), pe orice thread, se prinde;
+// apelantul asteapta oricum toate bucatile, pentru ca task-urile din cozi tin adresa lui fn, si abia apoi arunca mai
+// departe prima exceptie. Un task dat lui submit nu are cui sa-si dea exceptia: daca arunca, programul se opreste
+// (std::terminate), in loc sa lase cozile cu task-uri care arata spre o stiva deja eliberata.
+class ThreadPool {
+public:
+    struct Config {
+        unsigned threads = std::max(1u, std::thread::hardware_concurrency()) - 1; // apelantul este al N-lea
+        bool pinThreads = false; // fixeaza fiecare worker pe un core (doar pe Linux)
+        std::vector<int> cpus; // core-urile folosite la pinThreads; gol = 0, 1, 2, ...
+        bool background = false; // workerii cedeaza procesorul oricarui alt thread (doar pe Linux)
+    };
+
+    ThreadPool();
+    explicit ThreadPool(Config config);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool &) = delete;
+    ThreadPool &operator=(const ThreadPool &) = delete;
+
+    // runtime-ul comun al proiectului (generare, simulari, analize); configureShared trebuie apelat
+    // inainte de primul shared(), altfel se foloseste Config{}
+    static ThreadPool &shared();
+    static void configureShared(Config config);
+
+    void submit(std::function<void()> task);
+
+    // apeleaza fn(chunkBegin, chunkEnd) pentru intervale disjuncte de cel mult grain elemente care
+    // acopera [begin, end) si se intoarce dupa ce toate s-au terminat
+    template<typename Fn>
+    void parallelFor(std::int64_t begin, std::int64_t end, std::int64_t grain, const Fn &fn);
+
+    // map(chunkBegin, chunkEnd) -> T pe fiecare bucata, apoi combine in ordinea bucatilor (rezultat determinist)
+    template<typename T, typename Map, typename Combine>
+    T parallelReduce(std::int64_t begin, std::int64_t end, std::int64_t grain, T identity, const Map &map,
+                     const Combine &combine);
+
+    [[nodiscard]] unsigned workerCount() const;
+    [[nodiscard]] unsigned concurrency() const; // workeri + thread-ul apelant
+
+private:
+    struct Task {
+        void (*run)(const void *context, std::int64_t begin, std::int64_t end);
+        const void *context;
+        std::int64_t begin, end;
+        std::atomic<std::int64_t> *remaining; // contorul parallelFor-ului din care face parte, daca e cazul
+    };
+
+    struct Worker {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    void workerLoop(unsigned index);
+    void push(const Task *tasks, std::size_t count);
+    bool tryRunOne(); // executa un task (propriu sau furat); false daca toate cozile sunt goale
+    bool popOrSteal(Task &task);
+    static void execute(const Task &task) noexcept;
+    void waitFor(const std::atomic<std::int64_t> &remaining);
+
+    std::vector<std::unique_ptr<Worker>> m_queues;
+    std::vector<std::thread> m_threads;
+    std::atomic<std::int64_t> m_pending{0}; // task-uri aflate in cozi
+    std::atomic<unsigned> m_nextQueue{0}; // coada in care pune urmatorul task venit din afara pool-ului
+    std::mutex m_sleepMutex;
+    std::condition_variable m_wake;
+    bool m_stop{false};
+};
+
+template<typename Fn>
+void ThreadPool::parallelFor(const std::int64_t begin, const std::int64_t end, std::int64_t grain, const Fn &fn) {
+    if (begin >= end) {
+        return;
+    }
+    grain = std::max<std::int64_t>(grain, 1);
+    const std::int64_t chunks = (end - begin + grain - 1) / grain;
+
+    if (chunks == 1 || m_queues.empty()) {
+        fn(begin, end);
+        return;
+    }
+
+    // fiecare bucata isi prinde exceptia, ca niciuna sa nu iasa din parallelFor inainte de waitFor
+    std::exception_ptr error;
+    std::mutex errorMutex;
+    const auto guarded = [&](const std::int64_t chunkBegin, const std::int64_t chunkEnd) noexcept {
+        try {
+            fn(chunkBegin, chunkEnd);
+        }
+        catch (...) {
+            const std::lock_guard<std::mutex> lock(errorMutex);
+            if (!error) {
+                error = std::current_exception();
+            }
+        }
+    };
+    using Guarded = decltype(guarded);
+
+    std::atomic<std::int64_t> remaining{chunks - 1};
+    const auto run = [](const void *context, const std::int64_t chunkBegin, const std::int64_t chunkEnd) {
+        (*static_cast<const Guarded *>(context))(chunkBegin, chunkEnd);
+    };
+
+    std::vector<Task> tasks;
+    tasks.reserve((std::size_t) chunks - 1);
+    for (std::int64_t chunkBegin = begin + grain; chunkBegin < end; chunkBegin += grain) {
+        tasks.push_back(Task{run, &guarded, chunkBegin, std::min(end, chunkBegin + grain), &remaining});
+    }
+    push(tasks.data(), tasks.size());
+
+    guarded(begin, begin + grain); // prima bucata o face apelantul
+    waitFor(remaining);
+    if (error) {
+        std::rethrow_exception(error);
+    }
+}
+
+template<typename T, typename Map, typename Combine>
+T ThreadPool::parallelReduce(const std::int64_t begin, const std::int64_t end, std::int64_t grain, T identity,
+                             const Map &map, const Combine &combine) {
+    if (begin >= end) {
+        return identity;
+    }
+    grain = std::max<std::int64_t>(grain, 1);
+    const std::int64_t chunks = (end - begin + grain - 1) / grain;
+
+    std::vector<T> partial((std::size_t) chunks, identity);
+    parallelFor(0, chunks, 1, [&](const std::int64_t first, const std::int64_t last) {
+        for (std::int64_t chunk = first; chunk < last; chunk++) {
+            const std::int64_t chunkBegin = begin + chunk * grain;
+            partial[(std::size_t) chunk] = map(chunkBegin, std::min(end, chunkBegin + grain));
+        }
+    });
+
+    T result = std::move(identity);
+    for (T &value: partial) {
+        result = combine(std::move(result), std::move(value));
+    }
+    return result;
+}
+
+#endif //OOP_THREADPOOL_H
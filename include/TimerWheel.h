@@ -0,0 +1,47 @@
+#ifndef OOP_TIMERWHEEL_H
+#define OOP_TIMERWHEEL_H
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <unordered_map>
+#include <vector>
+
+// Hashed timer wheel: fiecare timer este pus in slotul corespunzator tick-ului la care expira,
+// iar advance() parcurge doar tick-urile scurse de la ultimul apel. Timerele care expira dupa
+// mai mult de o rotatie a rotii isi tin numarul de rotatii ramase in `rounds`.
+class TimerWheel {
+public:
+    using Clock = std::chrono::steady_clock;
+    using Callback = std::function<void()>;
+
+    explicit TimerWheel(Clock::time_point origin = Clock::now(),
+                        Clock::duration resolution = std::chrono::milliseconds(10),
+                        std::size_t slots = 512);
+
+    std::size_t schedule(Clock::duration delay, Callback callback); // intoarce id-ul timer-ului
+    void cancel(std::size_t id);
+    void advance(Clock::time_point now); // executa callback-urile tuturor timerelor expirate
+
+    [[nodiscard]] Clock::time_point nextExpiry() const; // momentul la care trebuie apelat din nou advance()
+    [[nodiscard]] bool empty() const;
+
+private:
+    struct Timer {
+        std::size_t id;
+        std::uint64_t rounds; // cate rotatii complete mai are de asteptat
+        Callback callback;
+    };
+
+    [[nodiscard]] Clock::time_point tickTime(std::uint64_t tick) const;
+
+    std::vector<std::vector<Timer>> m_slots;
+    std::unordered_map<std::size_t, std::size_t> m_slotOf; // id timer -> slot
+    Clock::duration m_resolution;
+    Clock::time_point m_origin;
+    Clock::time_point m_now;
+    std::uint64_t m_tick{}; // urmatorul tick care trebuie procesat
+    std::size_t m_nextId{};
+};
+
+#endif //OOP_TIMERWHEEL_H
@@ -0,0 +1,18 @@
+#ifndef OOP_VARINT_H
+#define OOP_VARINT_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Codare varint (LEB128): 7 biti de date pe octet, bitul cel mai semnificativ marcheaza ca mai urmeaza octeti.
+void writeVarint(std::vector<std::uint8_t> &out, std::uint64_t value);
+
+// citeste un varint de la pozitia pos si avanseaza pos; intoarce false daca datele s-au terminat
+bool readVarint(const std::vector<std::uint8_t> &in, std::size_t &pos, std::uint64_t &value);
+
+// celulele (0/1) impachetate cate 8 pe octet; readBitset citeste cells.size() biti de la pos
+void writeBitset(std::vector<std::uint8_t> &out, const std::vector<std::uint8_t> &cells);
+bool readBitset(const std::vector<std::uint8_t> &in, std::size_t &pos, std::vector<std::uint8_t> &cells);
+
+#endif //OOP_VARINT_H
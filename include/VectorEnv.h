@@ -0,0 +1,89 @@
+#ifndef OOP_VECTORENV_H
+#define OOP_VECTORENV_H
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "SplitMix64.h"
+
+// N jocuri independente, cu aceeasi dimensiune de labirint, avansate impreuna cu step(actions).
+// Starea este stocata struct-of-arrays (cate un vector pe camp, indexat dupa instanta), iar pasul
+// aplica regulile din Game::handleEvent fara apeluri virtuale si fara alocari.
+//
+// Diferente fata de Game: timpul se masoara in pasi (maxSteps per episod, bombRespawnSteps pana la o
+// bomba noua), iar o instanta terminata este resetata imediat cu un labirint nou, deci observatia
+// intoarsa pentru ea este deja cea a episodului urmator.
+class VectorEnv {
+public:
+    enum Action : std::uint8_t { // echivalentul tastelor din Game
+        Up,     // W
+        Left,   // A
+        Down,   // S
+        Right,  // D
+        Bomb,   // F
+        PickUp, // SPACE
+        Noop
+    };
+
+    // bitii din walls(): vecinii ocupati de pereti (sau in afara labirintului)
+    static constexpr std::uint8_t wallUp = 1, wallLeft = 2, wallDown = 4, wallRight = 8;
+
+    static constexpr float appleReward = 1.0f;
+    static constexpr float exitReward = 10.0f;
+
+    struct Observations {
+        std::span<const std::int16_t> row, col;
+        std::span<const std::uint16_t> applesLeft;
+        std::span<const std::uint8_t> hasBomb;
+        std::span<const std::int16_t> bombCol; // coloana bombei de pe randul 0, -1 daca nu exista
+        std::span<const std::uint8_t> walls;
+    };
+
+    struct StepResult {
+        Observations observations;
+        std::span<const float> rewards;
+        std::span<const std::uint8_t> done;
+    };
+
+    VectorEnv(int numEnvs, int mazeSize, std::uint64_t seed, int maxSteps = 0, int bombRespawnSteps = 50);
+
+    StepResult step(std::span<const std::uint8_t> actions); // actions.size() == size()
+
+    [[nodiscard]] Observations observations() const;
+    [[nodiscard]] int size() const;
+    [[nodiscard]] int getMazeSize() const;
+    [[nodiscard]] bool isWall(int env, int row, int col) const;
+    [[nodiscard]] bool hasApple(int env, int row, int col) const;
+
+private:
+    void reset(int env);
+    void stepRange(std::span<const std::uint8_t> actions, int begin, int end);
+    void stepOne(int env, std::uint8_t action);
+    void updateWalls(int env);
+    int randInt(int env, int from, int to);
+    [[nodiscard]] std::size_t cellIndex(int env, int row, int col) const;
+
+    int m_numEnvs;
+    int m_dim;
+    int m_cellsPerEnv;
+    int m_maxSteps;
+    int m_bombRespawnSteps;
+
+    // labirintele si merele tuturor instantelor, cate m_cellsPerEnv celule consecutive pe instanta
+    std::vector<std::uint8_t> m_wall;
+    std::vector<std::uint8_t> m_apple;
+
+    std::vector<std::int16_t> m_row, m_col;
+    std::vector<std::uint16_t> m_applesLeft;
+    std::vector<std::uint8_t> m_hasBomb;
+    std::vector<std::int16_t> m_bombCol;
+    std::vector<std::int32_t> m_bombRespawnIn; // pasi pana apare o bomba noua
+    std::vector<std::int32_t> m_steps;
+    std::vector<std::uint8_t> m_walls;
+    std::vector<float> m_reward;
+    std::vector<std::uint8_t> m_done;
+    std::vector<SplitMix64> m_rng;
+};
+
+#endif //OOP_VECTORENV_H
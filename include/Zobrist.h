@@ -0,0 +1,45 @@
+#ifndef OOP_ZOBRIST_H
+#define OOP_ZOBRIST_H
+
+#include <cstdint>
+
+#include "SplitMix64.h"
+#include "StateSync.h"
+
+// Hashing Zobrist al starii unui joc: fiecare element al starii (un perete, un mar, bomba de pe randul 0, pozitia
+// si bomba din mana fiecarui jucator) are o cheie fixa de 64 de biti, iar hash-ul este XOR-ul cheilor elementelor
+// prezente. O schimbare (un pas, un mar cules, un perete distrus) actualizeaza hash-ul in O(1) cu XOR-ul cheilor
+// afectate, fara sa parcurga labirintul.
+//
+// Cheile nu sunt tinute intr-un tabel, ci derivate din (element, index) cu SplitMix64, deci sunt aceleasi in orice
+// proces si pentru orice dimensiune de labirint; clientul si serverul pot compara hash-urile direct.
+class Zobrist {
+public:
+    enum class Feature : std::uint64_t { Wall, Apple, Bomb, Player, HasBomb };
+
+    static constexpr std::uint64_t key(const Feature feature, const std::uint64_t index) {
+        SplitMix64 mix{(index << 3) | (std::uint64_t) feature};
+        return mix();
+    }
+
+    static constexpr std::uint64_t cell(const Feature feature, const int dim, const int row, const int col) {
+        return key(feature, (std::uint64_t) row * dim + col);
+    }
+
+    static constexpr std::uint64_t player(const int player, const int dim, const int row, const int col) {
+        return key(Feature::Player, (std::uint64_t) player * dim * dim + (std::uint64_t) row * dim + col);
+    }
+
+    static constexpr std::uint64_t bomb(const int col) {
+        return key(Feature::Bomb, (std::uint64_t) col);
+    }
+
+    static constexpr std::uint64_t hasBomb(const int player) {
+        return key(Feature::HasBomb, (std::uint64_t) player);
+    }
+
+    // hash-ul calculat complet, egal cu cel tinut incremental de Game::stateHash si Arena::stateHash
+    static std::uint64_t hash(const SyncState &state);
+};
+
+#endif //OOP_ZOBRIST_H
@@ -1,501 +1,532 @@
+#include <algorithm>
+#include <chrono>
 #include <iostream>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <string>
+#include <filesystem>
+#include <fstream>
 #include <vector>
-#include <unordered_set>
-#include <chrono>
 #include <random.hpp>
 #include <rlutil.h>
 
-////////////////////// OBJECT CLASS DEFINITION ////////////////////////////
-
-class Object {
-public:
-    Object(const int row, const int col, const int color = rlutil::LIGHTRED) : m_crtRow(row), m_crtCol(col), m_color(color) {};
-    Object(const Object& obj) : m_crtRow(obj.m_crtRow), m_crtCol(obj.m_crtCol), m_color(obj.m_color) {} // NOLINT(*-use-equals-default)
-    // cc-ul de sus trebuie declarat cu = default
-    ~Object(); // destr
-
-    Object& operator=(const Object &obj); // operator=
-    friend std::ostream &operator<<(std::ostream &out, const Object &object);
-
-    std::pair<int, int> getPosition();
-
-private:
-    int m_crtRow, m_crtCol; // coordonatele obiectului
-    int m_color; // culoarea obiectului
-};
-
-Object::~Object() {
-    std::cout<<"Destr Object"<<std::endl;
-}
-
-Object &Object::operator=(const Object &obj) { // NOLINT(*-use-equals-default)
-    // suppress-ul este pentru ca op= ar trebui declarat cu = default
-
-    this->m_crtCol = obj.m_crtCol;
-    this->m_crtRow = obj.m_crtRow;
-    this->m_color = obj.m_color;
-
-    return *this;
-}
-
-std::ostream &operator<<(std::ostream &out, const Object &object) {
-    rlutil::setColor(object.m_color);
-    gotoxy(object.m_crtCol + 1, object.m_crtRow + 1);
-    out << 'O';
-    rlutil::setColor(rlutil::WHITE);
-    return out;
+#include "BigMaze.h"
+#include "Bot.h"
+#include "Calibration.h"
+#include "DifficultyTable.h"
+#include "EndlessGame.h"
+#include "Game.h"
+#include "LevelCache.h"
+#include "LevelCatalog.h"
+#include "LevelPipeline.h"
+#include "MazeAnalytics.h"
+#include "Recording.h"
+
+namespace {
+    // streambuf care ignora tot ce primeste
+    class NullBuffer : public std::streambuf {
+    protected:
+        int_type overflow(const int_type ch) override { return traits_type::not_eof(ch); }
+        std::streamsize xsputn(const char *, const std::streamsize n) override { return n; }
+    };
 }
 
-std::pair<int, int> Object::getPosition() {
-    return std::make_pair(m_crtRow, m_crtCol);
-}
-
-////////////////////////////// END OBJECT CLASS ///////////////////////////////////////
-
-
-
-
-
-
-
-
-
-
-
-////////////////////// MAZE CLASS DEFINITION ////////////////////////////
+#ifdef NEWTON_SERVER
+#include <csignal>
 
-class Maze {
-public:
-    explicit Maze(const int dim) : m_maze(std::vector<std::vector<char>>(dim, std::vector<char>(dim, '#'))),
-                                    m_dim(dim) {};
+#include "GameServer.h"
+#include "NetClient.h"
 
-    friend std::ostream &operator<<(std::ostream &out, const Maze &maze);
+namespace {
+    GameServer *runningServer = nullptr;
 
-    bool isPositionAvailable(int row, int col); // verifica daca o noua pozitie este buna
-    void generate(); // genereaza un labirint
-    void createHole(int row, int col); // distruge cei 8 vecini din jurul jucatorului cand a folosit bomba
-
-    std::vector<std::pair<int, int>> getFreeCells(); // cauta toate locurile libere din labirint
-
-private:
-    [[nodiscard]] bool isInside(int row, int col) const; // verifica daca coordonatele sunt in interiorul labirintului
-
-    std::vector<std::vector<char>> m_maze; // labirintul
-    int m_dim{}; // dimensiunea labirintului
-};
-
-std::ostream &operator<<(std::ostream &out, const Maze &maze) {
-    for (const auto &i: maze.m_maze) {
-        for (const auto &j: i) {
-            out << j;
+    void stopServer(int) {
+        if (runningServer != nullptr) {
+            runningServer->stop();
         }
-        out << std::endl;
     }
-    return out;
-}
-
-bool Maze::isInside(const int row, const int col) const {
-    return row >= 0 && col >= 0 && row < m_dim && col < m_dim;
-}
 
-void Maze::createHole(const int row, const int col) { // cand a fost bomba folosita se distrug cei 8 vecini din jurul jucatorului
-    // drdc = vector de directii (cei 8 vecini ai punctului (row, col))
-    const int drdc[8][2] = {{-1, -1}, // (row-1, col-1)
-                            {-1, 0}, // (row-1, col)
-                            {-1, 1}, // (row-1, col+1)
-                            {0,  1}, // (row, col+1)
-                            {1,  1}, // (row+1, col+1)
-                            {1,  0}, // (row+1, col)
-                            {1,  -1}, // (row+1, col - 1)
-                            {0,  -1}}; // (row, col-1)
-
-    for (const auto &direction: drdc) { // cppcheck-suppress constVariable
-        const int newRow = row + direction[0];
-        const int newCol = col + direction[1];
-        if (isInside(newRow, newCol) && m_maze[newRow][newCol] == '#') {
-            m_maze[newRow][newCol] = ' ';
+    int serve(const std::string &endpoint) {
+        // serverul nu are o consola a jocului; ce scriu obiectele jocului pe std::cout (de exemplu destructorii)
+        // ar incetini reactorul, asa ca este ignorat, iar mesajele serverului merg pe std::cerr
+        NullBuffer discard;
+        std::streambuf *const console = std::cout.rdbuf(&discard);
+
+        try {
+            effolkronium::random_static::seed(std::random_device{}());
+            GameServer server{Endpoint::parse(endpoint)};
+            runningServer = &server;
+            std::signal(SIGINT, stopServer);
+            std::signal(SIGTERM, stopServer);
+
+            std::cerr << "Serving on " << endpoint << std::endl;
+            server.run();
+            runningServer = nullptr;
+        }
+        catch (const std::exception &e) {
+            std::cout.rdbuf(console);
+            std::cerr << "Server failed: " << e.what() << std::endl;
+            return 1;
         }
-    }
-}
-
-std::vector<std::pair<int, int>> Maze::getFreeCells() { // cauta toate locurile libere din labirint
-    std::vector<std::pair<int, int>> result;
-    for (int row = 1; row < m_dim; row++) {
-        for (int col = 0; col < m_dim; col++)
-            if (m_maze[row][col] == ' ') {
-                result.emplace_back(row, col);
-            }
-    }
-    return result;
-}
-
-bool Maze::isPositionAvailable(const int row, const int col) {
-    return isInside(row, col) && m_maze[row][col] != '#';
-}
 
-// https://weblog.jamisbuck.org/2011/2/3/maze-generation-sidewinder-algorithm
-void Maze::generate() { // Pentru generarea labirintului a fost folosit algoritmul Sidewinder
-    for (int col = 0; col < m_dim; col++) {
-        m_maze[0][col] = ' ';
+        std::cout.rdbuf(console);
+        return 0;
     }
-    for (int row = 2; row < m_dim; row += 2) {
-        std::vector<std::pair<int, int>> run;
-        for (int col = 1; col < m_dim; col++) {
-            m_maze[row][col] = ' ';
-            run.emplace_back(row, col);
-
-            bool carve_east = effolkronium::random_static::get(0, 100) > 30; // daca continui sa sap la dreapta
 
-            if (carve_east && col + 1 < m_dim) {
-                m_maze[row][col + 1] = ' ';
+    int loadTest(const std::string &endpoint, const int sessions, const int keys, const int mazeSize, const int spectators) {
+        try {
+            const LoadTestResult result = runLoadTest(Endpoint::parse(endpoint), sessions, keys, mazeSize, std::random_device{}(),
+                                                      spectators);
+            std::cout << result.completed << "/" << result.sessions << " sessions completed, " << result.keysSent
+                      << " keys sent, " << result.bytesReceived << " bytes received in " << result.seconds << " s ("
+                      << (double) result.keysSent / result.seconds << " keys/s)" << std::endl;
+            if (result.spectators > 0) {
+                std::cout << result.spectators << " spectators received " << result.spectatorBytes << " bytes ("
+                          << (double) result.spectatorBytes / result.spectators / result.seconds
+                          << " bytes/s each), " << result.spectatorMessages << " messages applied, "
+                          << result.spectatorDesyncs << " desyncs" << std::endl;
             }
-            else { // sap in sus
-                std::pair<int, int> randomCell = run[effolkronium::random_static::get(0, (int)run.size()-1)];
-                m_maze[randomCell.first - 1][randomCell.second] = ' ';
-                if (randomCell.first + 1 < m_dim) {
-                    m_maze[randomCell.first + 1][randomCell.second] = ' ';
-                }
-                run.erase(run.begin(), run.end());
-                ++col;
+            if (result.spectatorsStarted < result.spectators) {
+                std::cerr << result.spectators - result.spectatorsStarted << "/" << result.spectators
+                          << " spectators received no state; is the server freshly started?" << std::endl;
             }
+            return result.completed == result.sessions && result.spectatorsStarted == result.spectators ? 0 : 1;
+        }
+        catch (const std::exception &e) {
+            std::cerr << "Load test failed: " << e.what() << std::endl;
+            return 1;
         }
     }
 }
+#endif
+
+namespace {
+    // nivelurile urmatoare se pregatesc in fundal cat timp se joaca cel curent
+    int runCampaign(const int mazeSize, const int levels, const std::string &cacheDirectory, const int fogRadius) {
+        try {
+            std::unique_ptr<LevelCache> cache;
+            if (!cacheDirectory.empty()) {
+                cache = std::make_unique<LevelCache>(cacheDirectory);
+            }
+            LevelPipeline pipeline{mazeSize, std::random_device{}(), 4, cache.get()};
+
+            rlutil::setCursorVisibility(false);
+            int completed = 0;
+            while (completed < levels) {
+                const PreparedLevel prepared = pipeline.next();
+                Game game{mazeSize};
+                game.setFogOfWar(fogRadius);
+                game.runLevel(*prepared.level, prepared.timeLimit);
+                if (!game.isWon()) {
+                    break;
+                }
+                ++completed;
+            }
+            rlutil::setCursorVisibility(true);
 
-////////////////////////////// END MAZE CLASS ///////////////////////////////////////
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-/////////////////////////// PLAYER CLASS DEFINITION ///////////////////////////////////////
-
-class Player {
-public:
-    Player() : m_crtRow(0), m_crtCol(0), m_hasBomb(false) {};
-
-    [[maybe_unused]] Player(const Player &player);
-    ~Player();
-
-    Player& operator=(std::pair<int, int> pos); // op=
-    friend std::ostream &operator<<(std::ostream &out, const Player &player);
-
-
-    void setHasBomb(bool val);
-    [[nodiscard]] bool getHasBomb() const;
-    std::pair<int, int> getPosition();
-
-private:
-    int m_crtRow, m_crtCol; // pozitia curenta a jucatorului
-    bool m_hasBomb;
-};
-
-Player::~Player() {
-    std::cout<<"Destr Player"<<std::endl;
-}
-
-[[maybe_unused]] Player::Player(const Player &player) {
-    this->m_crtRow = player.m_crtRow;
-    this->m_crtCol = player.m_crtCol;
-    this->m_hasBomb = player.m_hasBomb;
-}
-
-Player &Player::operator=(const std::pair<int, int> pos) {
-    m_crtRow = pos.first;
-    m_crtCol = pos.second;
-    return *this;
-}
-
-std::ostream& operator<<(std::ostream &out, const Player &player) {
-    rlutil::setColor(rlutil::BROWN);
-
-    gotoxy(player.m_crtCol + 1, player.m_crtRow + 1);
-    out << 'T';
-    rlutil::setColor(rlutil::WHITE);
-
-    return out;
-}
-
-void Player::setHasBomb(const bool val) {
-    m_hasBomb = val;
-}
-
-bool Player::getHasBomb() const {
-    return m_hasBomb;
-}
-
-std::pair<int, int> Player::getPosition() {
-    return std::pair<int, int>{m_crtRow, m_crtCol};
-}
-
-/////////////////////////////////// END PLAYER CLASS /////////////////////////////////////////////
-
-
-
-
-
-
-
-
-
-
-
-//////////////////////// GAME CLASS DEFINITION //////////////////////////////////////////
-
-class Game {
-public:
-    explicit Game(const int maze_size) : m_maze(maze_size), bomb{0, effolkronium::random_static::get(2, maze_size - 1), rlutil::CYAN},
-                                          m_mazeSize(maze_size), m_isRunning(true), m_toggleRender(true) {};
-
-    void run();
-
-private:
-    void handleEvent(bool &renderFlag);
-    void render();
-
-    Maze m_maze;
-    Player m_player;
-    Object bomb;
-    std::vector<Object> objects;
-    std::chrono::system_clock::time_point clock;
-    std::chrono::system_clock::time_point gameStarted;
-    std::chrono::system_clock::time_point lastRender;
-
-    int m_totalTime{}; // timpul total alocat jocului
-    int m_mazeSize{};
-    bool m_isRunning{}; // flag pentru a mentine rularea jocului
-    bool m_toggleRender{}; // flag ca sa fac render doar atunci cand s-a intamplat ceva
-};
-
-void Game::run() {
-    m_maze.generate();
-    gameStarted = std::chrono::system_clock::now();
-
-    const std::vector<std::pair<int, int>> mazeFreeCells = m_maze.getFreeCells();
-
-    int upperLimit = (int) mazeFreeCells.size() / 2;
-    int lowerLimit = 5;
-
-    if(upperLimit < lowerLimit) {
-        std::swap(lowerLimit, upperLimit);
+            std::cout << "Completed " << completed << "/" << levels << " levels" << std::endl;
+        }
+        catch (const std::exception &e) {
+            rlutil::setCursorVisibility(true);
+            std::cerr << "Campaign failed: " << e.what() << std::endl;
+            return 1;
+        }
+        return 0;
     }
 
-    int numberOfRandomObjects = effolkronium::random_static::get(lowerLimit, upperLimit);
-    std::unordered_set<int> usedIndex; // marchez indicii folositi pentru a nu avea mai multe obiecte
-    // in aceeasi locatie
-
-    if(numberOfRandomObjects > 60) {
-        numberOfRandomObjects = 60;
+    int runBakedLevel(const Level &level, const int fogRadius) {
+        rlutil::setCursorVisibility(false);
+        {
+            Game game{level.dim};
+            game.setFogOfWar(fogRadius);
+            game.runLevel(level, LevelPipeline::timeLimit(level));
+        }
+        rlutil::setCursorVisibility(true);
+        return 0;
     }
 
-    for (int i = 0; i < numberOfRandomObjects; i++) { // aici generez obiecte (mere) random in labirint
-        const int randIndex = effolkronium::random_static::get(0, (int) mazeFreeCells.size() - 1);
-
-        if(usedIndex.find(randIndex) == usedIndex.end()) { // daca nu am mai folosit indexul randIndex
-            const std::pair<int, int> randomPos = mazeFreeCells[randIndex];
-            const Object obj{randomPos.first, randomPos.second};
-            objects.push_back(obj);
-
-            usedIndex.insert(randIndex);
+    // jocuri fara afisare jucate de un bot; se raporteaza viteza si cate jocuri a castigat
+    int runBot(const std::string &policyName, const int mazeSize, const int games, const std::uint64_t seed) {
+        // ce scriu obiectele jocului pe std::cout (destructorii) doar ar incetini jocurile
+        NullBuffer discard;
+        std::streambuf *const console = std::cout.rdbuf(&discard);
+        try {
+            const BotStats stats = runBotGames(policyName, mazeSize, games, seed);
+            std::cout.rdbuf(console);
+
+            std::cout << policyName << " bot: " << stats.games << " games on " << mazeSize << "x" << mazeSize
+                      << " (seed " << seed << ") in " << stats.seconds << " s on "
+                      << ThreadPool::shared().concurrency() << " threads, " << stats.gamesPerSecond()
+                      << " games/s (" << stats.gamesPerSecond() * 60 << " per minute), "
+                      << (double) stats.keys / stats.games << " keys per game" << std::endl
+                      << "Win rate: " << stats.winRate() * 100 << "% (" << stats.wins << "/" << stats.games << ")"
+                      << std::endl;
         }
-
+        catch (const std::exception &e) {
+            std::cout.rdbuf(console);
+            std::cerr << "Bot run failed: " << e.what() << std::endl;
+            return 1;
+        }
+        return 0;
     }
 
-    m_totalTime = (int) objects.size() / 10;
-    if(m_totalTime == 0) {
-        m_totalTime = 1;
+    // calibrarea timpului acordat nivelurilor; tabela scrisa in outputPath se incarca la pornire cu --difficulty
+    int runCalibration(const std::string &outputPath, const std::vector<int> &sizes, const int games,
+                       const int winRatePercent, const std::uint64_t seed) {
+        CalibrationConfig config;
+        if (!sizes.empty()) {
+            config.sizes = sizes;
+        }
+        if (games > 0) {
+            config.games = games;
+        }
+        config.targetWinRate = winRatePercent / 100.0;
+        config.seed = seed;
+
+        // jocurile simulate ruleaza pe toate thread-urile, iar destructorii obiectelor scriu pe std::cout
+        NullBuffer discard;
+        std::streambuf *const console = std::cout.rdbuf(&discard);
+        try {
+            const CalibrationResult result = calibrate(config);
+            std::cout.rdbuf(console);
+            result.table.save(outputPath);
+
+            for (const DifficultyTable::Row &row: result.table.rows()) {
+                std::cout << row.size << "x" << row.size << ": " << row.secondsPerStep << " s per step, "
+                          << row.winRate * 100 << "% of " << row.games << " simulated games won in time" << std::endl;
+            }
+            std::cout << result.games << " games (" << result.keys << " keys) in " << result.seconds << " s on "
+                      << ThreadPool::shared().concurrency() << " threads; table written to " << outputPath << std::endl;
+        }
+        catch (const std::exception &e) {
+            std::cout.rdbuf(console);
+            std::cerr << "Calibration failed: " << e.what() << std::endl;
+            return 1;
+        }
+        return 0;
     }
-    bool timeExpired = false;
 
-    while (m_isRunning) {
-        const std::chrono::system_clock::time_point currentTime = std::chrono::system_clock::now();
-        const int minutesPassed = (int) std::chrono::duration_cast<std::chrono::minutes>(currentTime - gameStarted).count();
-        const int renderInterval = (int) std::chrono::duration_cast<std::chrono::minutes>(currentTime - lastRender).count();
-
-        if(minutesPassed >= m_totalTime) { // a trecut timpul alocat jocului -> il opresc
-            m_isRunning = false;
-            timeExpired = true;
-            continue;
+    // metricile labirinturilor generate, pe dimensiuni, scrise ca CSV in outputPath
+    int runAnalytics(const std::string &outputPath, const std::vector<int> &sizes, const int mazes, const std::uint64_t seed) {
+        AnalyticsConfig config;
+        if (!sizes.empty()) {
+            config.sizes = sizes;
         }
-        if(renderInterval >= 1) { // pentru a actualiza textul legat de time remaining
-            m_toggleRender = true;
+        if (mazes > 0) {
+            config.mazes = (std::uint64_t) mazes;
         }
+        config.firstSeed = seed;
 
-        handleEvent(m_toggleRender);
+        try {
+            const AnalyticsResult result = analyzeMazes(config);
+            std::ofstream file(outputPath);
+            if (!file) {
+                throw std::runtime_error("cannot write " + outputPath);
+            }
+            writeAnalyticsCsv(file, config, result);
 
-        if (m_toggleRender) {
-            render();
-            m_toggleRender = false;
-            lastRender = std::chrono::system_clock::now();
+            const std::uint64_t total = config.mazes * config.sizes.size();
+            std::cout << total << " mazes analyzed in " << result.seconds << " s (" << (double) total / result.seconds
+                      << " mazes/s on " << ThreadPool::shared().concurrency() << " threads); results written to "
+                      << outputPath << std::endl;
         }
-
-        if (bomb.getPosition().second == m_mazeSize - 1) { // atunci cand o bomba a fost luata noua pozitie va fi in dreapta
-            // conditia de sus verifica daca bomba a fost luata in functie de pozitia bombei
-            const int secondsPassed = (int) std::chrono::duration_cast<std::chrono::seconds >(currentTime - clock).count();
-            if (secondsPassed >= 5) { // daca au trecut 5 secunde de cand bomba a fost luata atunci generez una noua
-                const Object newBomb = Object{0, effolkronium::random_static::get(2, m_mazeSize - 2), rlutil::CYAN};
-                bomb = newBomb;
-                m_toggleRender = true;
-            }
+        catch (const std::exception &e) {
+            std::cerr << "Analytics failed: " << e.what() << std::endl;
+            return 1;
         }
-
+        return 0;
     }
 
-    rlutil::cls();
-
-    if(objects.empty() && !timeExpired) {
-        std::cout << "Newton found his apples. Now he will study the laws of gravity."<<std::endl;
-    }
-    else {
-        std::cout << "Newton couldn't find its apples."<<std::endl;
+    // labirint de stres generat direct pe disc si rezolvat pe benzi, cu cel mult memoryMiB MiB de memorie; cu
+    // exportImages se scriu si labirintul (.pbm) si harta distantelor (.pgm) langa el
+    int runStress(const int mazeSize, const std::uint64_t seed, const int memoryMiB, const std::filesystem::path &directory,
+                  const bool exportImages) {
+        try {
+            std::filesystem::create_directories(directory);
+            const std::filesystem::path mazePath = directory / ("stress_" + std::to_string(mazeSize) + "_" +
+                                                                std::to_string(seed) + ".maze");
+            const auto started = std::chrono::steady_clock::now();
+            BigMaze::generate(mazePath, mazeSize, seed);
+            const auto generated = std::chrono::steady_clock::now();
+            const BigMaze::Solution solution = BigMaze{mazePath}.solve(directory / "stress.dist",
+                                                                       (std::size_t) memoryMiB << 20);
+            const auto solved = std::chrono::steady_clock::now();
+
+            std::cout << "Maze " << mazeSize << "x" << mazeSize << " (seed " << seed << ") written to " << mazePath.string()
+                      << " in " << std::chrono::duration<double>(generated - started).count() << " s" << std::endl
+                      << "Solved in " << std::chrono::duration<double>(solved - generated).count() << " s: "
+                      << solution.sweeps << " sweeps over bands of " << solution.bandRows << " rows, "
+                      << solution.bytesRead / 1000000 << " MB read, " << solution.bytesWritten / 1000000
+                      << " MB written" << std::endl
+                      << "Reachable cells: " << solution.reachableCells << std::endl
+                      << "Solution length to (" << solution.goal.first << ", " << solution.goal.second << "): "
+                      << solution.solutionLength << std::endl
+                      << "Reachable apples: " << solution.reachableApples << "/" << solution.apples << std::endl;
+            if (exportImages) {
+                const BigMaze maze{mazePath};
+                std::filesystem::path pbmPath = mazePath, pgmPath = mazePath;
+                pbmPath.replace_extension(".pbm");
+                pgmPath.replace_extension(".pgm");
+                std::ofstream pbm(pbmPath, std::ios::binary);
+                maze.writePbm(pbm);
+                std::ofstream pgm(pgmPath, std::ios::binary);
+                maze.writeHeatmap(directory / "stress.dist", pgm);
+                std::cout << "Images written to " << pbmPath.string() << " and " << pgmPath.string() << std::endl;
+            }
+            std::filesystem::remove(directory / "stress.dist");
+        }
+        catch (const std::exception &e) {
+            std::cerr << "Stress level failed: " << e.what() << std::endl;
+            return 1;
+        }
+        return 0;
     }
 }
 
-void Game::render() {
-    rlutil::cls();
-
-    std::cout << m_maze;
-
-    const std::chrono::system_clock::time_point currentTime = std::chrono::system_clock::now();
-    const int minutesPassed = (int) std::chrono::duration_cast<std::chrono::minutes>(currentTime - gameStarted).count();
-
-    std::cout<<std::endl<<"Time remaining: " << m_totalTime - minutesPassed << " minutes left.";
-
-    const int applesLeft = (int) objects.size();
-
-    if(applesLeft == 0) {
-        std::cout<<std::endl<<"You've collected all the apples! The exit is marked with ";
-        rlutil::setColor(rlutil::LIGHTGREEN);
-        std::cout<<"<<";
-        rlutil::setColor(rlutil::WHITE);
-    }
-    else {
-        std::cout<<std::endl<<"Apples left to collect: " << applesLeft;
+// Utilizare:
+//   oop                          joc interactiv, sesiunea se salveaza in last_session.replay
+//   oop --record <fisier>        joc interactiv, sesiunea se salveaza in <fisier>
+//   oop --replay <fisier> [--fast]  reia o sesiune in timp real sau cat de repede se poate (fara afisare)
+//   oop --levels N [--size N] [--level-cache <dir>]  campanie de N niveluri la rand (nu se inregistreaza)
+//   oop --tutorial / --daily     nivelul de antrenament sau nivelul zilei (coapte in binar)
+//   oop --endless [--seed N] [--world-dir <dir>]  labirint infinit; gaurile facute de bombe se pastreaza in <dir>
+//   oop --stress N [--seed N] [--memory MiB] [--stress-dir <dir>] [--export]  labirint N x N generat in <dir> si
+//                                rezolvat fara sa fie tinut in memorie; afiseaza lungimea solutiei si merele
+//                                accesibile, iar cu --export scrie si imaginile PBM/PGM ale labirintului si distantelor
+//   oop --bot greedy|route|bomb [--games N] [--size N] [--seed N]  N jocuri fara afisare jucate de un bot;
+//                                afiseaza jocurile pe secunda si procentul de jocuri castigate
+//   oop --calibrate <fisier.csv> [--sizes 10,20,...] [--games N] [--win-rate P] [--seed N]  calibreaza timpul
+//                                acordat nivelurilor din N jocuri simulate pe dimensiune, ca P% sa fie castigate
+//   oop --analyze <fisier.csv> [--sizes 10,20,...] [--mazes N] [--seed N]  metricile de calitate ale labirinturilor
+//                                generate din seed-urile N ... N + mazes - 1, pe dimensiuni
+//   --difficulty <fisier.csv>    tabela de timpi incarcata la pornire (implicit difficulty.csv, daca exista)
+//   --fog R                      ceata de razboi in jocurile interactive: se vede doar pana la R celule de jucator
+// Doar pe Linux (<endpoint> este unix:<cale> sau tcp:<port>):
+//   oop --serve <endpoint>       server cu multe sesiuni de joc
+//   oop --connect <endpoint> [--size N]  joc interactiv pe un server
+//   oop --watch <endpoint> --game N  spectator al sesiunii N
+//   oop --loadtest <endpoint> [--sessions N] [--keys N] [--size N] [--spectators N]  client de test cu N sesiuni
+//                                simultane si, optional, N spectatori pe sesiune
+int main(int argc, char *argv[]) {
+    const std::vector<std::string> args(argv + 1, argv + argc);
+    std::string recordPath = "last_session.replay";
+    std::string replayPath;
+    bool fastReplay = false, tutorial = false, daily = false, endless = false, exportImages = false;
+    std::string serveEndpoint, connectEndpoint, watchEndpoint, loadTestEndpoint, levelCache, worldDirectory = "endless_world";
+    std::string stressDirectory = ".", botPolicy, calibrationPath, analyticsPath;
+    std::string difficultyPath = DifficultyTable::defaultPath;
+    int sessions = 100, keys = 100, mazeSize = 25, spectators = 0, gameId = 1, levels = 0, worldSeed = -1;
+    int stressSize = 0, memoryMiB = 256, games = 0, winRate = 80, mazes = 0, fogRadius = 0;
+    std::vector<int> sizeList;
+
+    for (std::size_t i = 0; i < args.size(); i++) {
+        const bool hasValue = i + 1 < args.size();
+        if (args[i] == "--record" && hasValue) {
+            recordPath = args[++i];
+        }
+        else if (args[i] == "--replay" && hasValue) {
+            replayPath = args[++i];
+        }
+        else if (args[i] == "--fast") {
+            fastReplay = true;
+        }
+        else if (args[i] == "--tutorial") {
+            tutorial = true;
+        }
+        else if (args[i] == "--daily") {
+            daily = true;
+        }
+        else if (args[i] == "--endless") {
+            endless = true;
+        }
+        else if (args[i] == "--world-dir" && hasValue) {
+            worldDirectory = args[++i];
+        }
+        else if (args[i] == "--export") {
+            exportImages = true;
+        }
+        else if (args[i] == "--stress-dir" && hasValue) {
+            stressDirectory = args[++i];
+        }
+        else if (args[i] == "--serve" && hasValue) {
+            serveEndpoint = args[++i];
+        }
+        else if (args[i] == "--connect" && hasValue) {
+            connectEndpoint = args[++i];
+        }
+        else if (args[i] == "--watch" && hasValue) {
+            watchEndpoint = args[++i];
+        }
+        else if (args[i] == "--loadtest" && hasValue) {
+            loadTestEndpoint = args[++i];
+        }
+        else if (args[i] == "--bot" && hasValue) {
+            botPolicy = args[++i];
+        }
+        else if (args[i] == "--level-cache" && hasValue) {
+            levelCache = args[++i];
+        }
+        else if (args[i] == "--calibrate" && hasValue) {
+            calibrationPath = args[++i];
+        }
+        else if (args[i] == "--analyze" && hasValue) {
+            analyticsPath = args[++i];
+        }
+        else if (args[i] == "--difficulty" && hasValue) {
+            difficultyPath = args[++i];
+        }
+        else if (args[i] == "--sizes" && hasValue) {
+            std::stringstream list(args[++i]);
+            std::string item;
+            try {
+                while (std::getline(list, item, ',')) {
+                    sizeList.push_back(std::stoi(item));
+                }
+            }
+            catch (const std::exception &) {
+                std::cerr << "Invalid size list: " << args[i] << std::endl;
+                return 1;
+            }
+        }
+        else if ((args[i] == "--sessions" || args[i] == "--keys" || args[i] == "--size" || args[i] == "--spectators" ||
+                  args[i] == "--game" || args[i] == "--levels" || args[i] == "--seed" || args[i] == "--stress" ||
+                  args[i] == "--memory" || args[i] == "--games" || args[i] == "--win-rate" ||
+                  args[i] == "--mazes" || args[i] == "--fog") && hasValue) {
+            int &target = args[i] == "--sessions" ? sessions : args[i] == "--keys" ? keys : args[i] == "--size" ? mazeSize
+                        : args[i] == "--spectators" ? spectators : args[i] == "--game" ? gameId
+                        : args[i] == "--levels" ? levels : args[i] == "--stress" ? stressSize
+                        : args[i] == "--memory" ? memoryMiB : args[i] == "--games" ? games
+                        : args[i] == "--win-rate" ? winRate : args[i] == "--mazes" ? mazes
+                        : args[i] == "--fog" ? fogRadius : worldSeed;
+            try {
+                target = std::stoi(args[++i]);
+            }
+            catch (const std::exception &) {
+                std::cerr << "Invalid number for " << args[i - 1] << ": " << args[i] << std::endl;
+                return 1;
+            }
+        }
+        else {
+            std::cerr << "Unknown argument: " << args[i] << std::endl;
+            return 1;
+        }
     }
 
-    // aici marchez iesirea din labirint
-    const int objectsRemained = (int) objects.size();
-    if (objectsRemained != 0) {
-        gotoxy(1, 1);
-        rlutil::setColor(rlutil::LIGHTRED);
-        std::cout << ">>";
-        rlutil::setColor(rlutil::WHITE);
-    }
-    else {
-        gotoxy(1, 1);
-        rlutil::setColor(rlutil::LIGHTGREEN);
-        std::cout << "<<";
-        rlutil::setColor(rlutil::WHITE);
+    // fara difficulty.csv se pastreaza regula fixa; o tabela data explicit sau stricata se semnaleaza
+    if (difficultyPath != DifficultyTable::defaultPath || std::filesystem::exists(difficultyPath)) {
+        try {
+            DifficultyTable::shared() = DifficultyTable::load(difficultyPath);
+        }
+        catch (const std::exception &e) {
+            std::cerr << "Ignoring difficulty table: " << e.what() << std::endl;
+        }
     }
 
-    std::cout << bomb;
-    for (Object &obj: objects) { // afisez merele pe ecran
-        std::cout << obj;
+#ifdef NEWTON_SERVER
+    if (!serveEndpoint.empty()) {
+        return serve(serveEndpoint);
     }
-
-    std::cout << m_player;
-    std::cout.flush();
-}
-
-void Game::handleEvent(bool &renderFlag) {
-    const int key_pressed = rlutil::nb_getch();
-    std::pair<int, int> playerPosition = m_player.getPosition();
-    const int crtRow = playerPosition.first;
-    const int crtCol = playerPosition.second;
-
-    if (objects.empty() && crtRow == 0 && crtCol == 0) {
-        m_isRunning = false;
-        return;
+    if (!loadTestEndpoint.empty()) {
+        return loadTest(loadTestEndpoint, sessions, keys, mazeSize, spectators);
     }
-
-    switch (std::tolower(key_pressed)) {
-        case rlutil::KEY_SPACE: {
-            std::erase_if(objects, [&](Object item) {
-                const std::pair<int, int> objPosition = item.getPosition();
-                return playerPosition == objPosition;
-            }); // daca jucatorul se afla pe un obiect inseamna ca a luat obiectul => il sterg din vector
-
-            std::pair<int, int> bombPosition = bomb.getPosition();
-
-            if (playerPosition == bombPosition && bombPosition.second != m_mazeSize - 1) { // daca jucatorul a luat bomba
-                // si bomba a fost generata
-                m_player.setHasBomb(true);
-                const Object offBomb{0, m_mazeSize - 1, rlutil::LIGHTGREEN};
-                bomb = offBomb;
-
-                clock = std::chrono::system_clock::now(); // cronometrez cat timp a trecut de cand bomba a fost luata
-            }
-
-            renderFlag = true;
-
-            break;
+    if (!watchEndpoint.empty()) {
+        try {
+            rlutil::setCursorVisibility(false);
+            runSpectator(Endpoint::parse(watchEndpoint), (std::uint64_t) gameId);
+            rlutil::setCursorVisibility(true);
         }
-
-        case 'f': {
-            if (m_player.getHasBomb()) { // jucatorul vrea sa foloseasca bomba
-                m_maze.createHole(crtRow, crtCol);
-                m_player.setHasBomb(false);
-            }
-
-            renderFlag = true;
-            break;
+        catch (const std::exception &e) {
+            rlutil::setCursorVisibility(true);
+            std::cerr << "Connection failed: " << e.what() << std::endl;
+            return 1;
         }
-        case 'w': {
-            if (m_maze.isPositionAvailable(crtRow - 1, crtCol)) {
-                m_player = std::make_pair(crtRow - 1, crtCol);
-            }
-
-            renderFlag = true;
-            break;
+        return 0;
+    }
+    if (!connectEndpoint.empty()) {
+        try {
+            rlutil::setCursorVisibility(false);
+            runInteractiveClient(Endpoint::parse(connectEndpoint), mazeSize);
+            rlutil::setCursorVisibility(true);
         }
-        case 'a': {
-            if (m_maze.isPositionAvailable(crtRow, crtCol - 1)) {
-                m_player = std::make_pair(crtRow, crtCol - 1);
-            }
-
-            renderFlag = true;
-            break;
+        catch (const std::exception &e) {
+            rlutil::setCursorVisibility(true);
+            std::cerr << "Connection failed: " << e.what() << std::endl;
+            return 1;
         }
-        case 's': {
-            if (m_maze.isPositionAvailable(crtRow + 1, crtCol)) {
-                m_player = std::make_pair(crtRow + 1, crtCol);
-            }
-
-            renderFlag = true;
-            break;
+        return 0;
+    }
+#else
+    if (!serveEndpoint.empty() || !connectEndpoint.empty() || !watchEndpoint.empty() || !loadTestEndpoint.empty()) {
+        std::cerr << "The multiplayer server is only available on Linux" << std::endl;
+        return 1;
+    }
+#endif
+
+    if (!replayPath.empty()) {
+        try {
+            const Recording recording = Recording::load(replayPath);
+            effolkronium::random_static::seed(recording.getSeed());
+
+            rlutil::setCursorVisibility(fastReplay);
+            const auto started = std::chrono::steady_clock::now();
+            Game game{recording.getMazeSize()};
+            game.setFogOfWar(fogRadius);
+            game.replay(recording, !fastReplay);
+            const auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - started);
+            rlutil::setCursorVisibility(true);
+
+            std::cout << "Replayed " << recording.getEvents().size() << " events in " << elapsed.count() << " s" << std::endl;
         }
-        case 'd': {
-            if (m_maze.isPositionAvailable(crtRow, crtCol + 1)) {
-                m_player = std::make_pair(crtRow, crtCol + 1);
-            }
+        catch (const std::exception &e) {
+            std::cerr << "Replay failed: " << e.what() << std::endl;
+            return 1;
+        }
+        return 0;
+    }
 
-            renderFlag = true;
-            break;
+    if (endless) {
+        // fara --seed se alege o lume noua; seed-ul se afiseaza ca lumea sa poata fi reluata
+        const std::uint64_t seed = worldSeed >= 0 ? (std::uint64_t) worldSeed : std::random_device{}() & 0x7FFFFFFF;
+        try {
+            rlutil::setCursorVisibility(false);
+            EndlessGame{seed, worldDirectory}.run();
+            rlutil::setCursorVisibility(true);
         }
-        case 'q': { // exit
-            m_isRunning = false;
-            break;
+        catch (const std::exception &e) {
+            rlutil::setCursorVisibility(true);
+            std::cerr << "Endless mode failed: " << e.what() << std::endl;
+            return 1;
         }
-        default:
-            break;
+        std::cout << "World seed: " << seed << std::endl;
+        return 0;
+    }
+    if (!botPolicy.empty()) {
+        return runBot(botPolicy, std::clamp(mazeSize, 10, 30), games > 0 ? games : 1000,
+                      worldSeed >= 0 ? (std::uint64_t) worldSeed : 1);
+    }
+    if (!calibrationPath.empty()) {
+        return runCalibration(calibrationPath, sizeList, games, std::clamp(winRate, 1, 100),
+                              worldSeed >= 0 ? (std::uint64_t) worldSeed : 1);
+    }
+    if (!analyticsPath.empty()) {
+        return runAnalytics(analyticsPath, sizeList, mazes, worldSeed >= 0 ? (std::uint64_t) worldSeed : 0);
+    }
+    if (stressSize > 0) {
+        return runStress(std::max(stressSize, 10), worldSeed >= 0 ? (std::uint64_t) worldSeed : 1,
+                         std::max(memoryMiB, 1), stressDirectory, exportImages);
+    }
+    if (tutorial) {
+        return runBakedLevel(LevelCatalog::tutorial.toLevel(), fogRadius);
+    }
+    if (daily) { // ziua saptamanii in UTC, ca toti jucatorii sa aiba acelasi nivel
+        const std::chrono::weekday today{std::chrono::floor<std::chrono::days>(std::chrono::system_clock::now())};
+        return runBakedLevel(LevelCatalog::daily[today.c_encoding()].toLevel(), fogRadius);
+    }
+    if (levels > 0) {
+        return runCampaign(std::clamp(mazeSize, 10, 30), levels, levelCache, fogRadius);
     }
-}
-
-//////////////////////////// END GAME CLASS ////////////////////////////////////////
-
 
-int main() {
     rlutil::setCursorVisibility(false);
 
     int dim_maze = 25;
@@ -503,17 +534,32 @@ int main() {
     std::cout << "Enter maze size (default=25, min=10, max=30): ";
     std::cin >> dim_maze;
 
-    if (dim_maze < 10) {
-        dim_maze = 10;
+    if (dim_maze < Recording::minMazeSize) {
+        dim_maze = Recording::minMazeSize;
     }
-    else if (dim_maze > 30) {
-        dim_maze = 30;
+    else if (dim_maze > Recording::maxMazeSize) {
+        dim_maze = Recording::maxMazeSize;
     }
 
-    Game game{dim_maze};
-    game.run();
+    // seed-ul este salvat in inregistrare, ca sesiunea sa poata fi reluata identic
+    const std::uint32_t seed = std::random_device{}();
+    effolkronium::random_static::seed(seed);
+
+    Recording recording{seed, dim_maze};
+    {
+        Game game{dim_maze};
+        game.setFogOfWar(fogRadius);
+        game.run(recording);
+    }
 
     rlutil::setCursorVisibility(true);
 
+    try {
+        recording.save(recordPath);
+    }
+    catch (const std::exception &e) {
+        std::cerr << e.what() << std::endl;
+    }
+
     return 0;
 }
@@ -0,0 +1,311 @@
+#include "Arena.h"
+
+#include <random>
+#include <stdexcept>
+
+#include <rlutil.h>
+
+#include "Zobrist.h"
+
+Arena::Arena(const int mazeSize, const int players, const std::uint64_t seed, const int bombRespawnTicks)
+        : m_maze(mazeSize), m_dim(mazeSize), m_bombRespawnTicks(bombRespawnTicks), m_rng(seed),
+          m_players(players), m_scores(players), m_inputs(players), m_actions(players),
+          m_apple((std::size_t) mazeSize * mazeSize) {
+    if (players < 1 || mazeSize < 4) {
+        throw std::invalid_argument("Arena needs at least one player and a maze size of at least 4");
+    }
+
+    m_maze.generate(m_rng());
+    placeApples();
+    m_bombCol = std::uniform_int_distribution<int>{2, m_dim - 2}(m_rng);
+
+    m_hash ^= Zobrist::bomb(m_bombCol); // merele sunt deja in hash, din placeApples
+    for (int player = 0; player < players; player++) {
+        m_hash ^= Zobrist::player(player, m_dim, 0, 0);
+    }
+}
+
+void Arena::placeApples() {
+    const int freeCells = (int) m_maze.getFreeCells().size();
+    int lowerLimit = 5;
+    int upperLimit = freeCells / 2;
+    if (upperLimit < lowerLimit) {
+        std::swap(lowerLimit, upperLimit);
+    }
+    // mai multe mere decat in Game, ca sa aiba pentru ce concura toti jucatorii
+    const int numberOfApples = std::min(std::uniform_int_distribution<int>{lowerLimit, upperLimit}(m_rng),
+                                        std::max(60, (int) m_players.size()));
+
+    for (int i = 0; i < numberOfApples && freeCells > 0; i++) {
+        int row = 0;
+        int col = 0;
+        do { // merele stau doar sub randul 0, ca in Game
+            row = std::uniform_int_distribution<int>{1, m_dim - 1}(m_rng);
+            col = std::uniform_int_distribution<int>{0, m_dim - 1}(m_rng);
+        } while (m_maze.isWall(row, col));
+
+        std::uint8_t &apple = m_apple[cellIndex(row, col)];
+        if (!apple) {
+            apple = 1;
+            ++m_applesLeft;
+            m_hash ^= Zobrist::cell(Zobrist::Feature::Apple, m_dim, row, col);
+        }
+    }
+}
+
+std::size_t Arena::cellIndex(const int row, const int col) const {
+    return (std::size_t) row * m_dim + col;
+}
+
+bool Arena::pushInput(const int player, const char key) {
+    return m_inputs[player].tryPush(key);
+}
+
+void Arena::move(const int player, const char key) {
+    const auto [row, col] = m_players[player].getPosition();
+    int newRow = row;
+    int newCol = col;
+
+    switch (key) {
+        case 'w':
+            --newRow;
+            break;
+        case 'a':
+            --newCol;
+            break;
+        case 's':
+            ++newRow;
+            break;
+        case 'd':
+            ++newCol;
+            break;
+        default:
+            return;
+    }
+
+    if (m_maze.isPositionAvailable(newRow, newCol)) {
+        m_players[player] = std::pair<int, int>{newRow, newCol};
+        m_hash ^= Zobrist::player(player, m_dim, row, col) ^ Zobrist::player(player, m_dim, newRow, newCol);
+    }
+}
+
+void Arena::detonate(const int player) {
+    const auto [row, col] = m_players[player].getPosition();
+    for (int r = row - 1; r <= row + 1; r++) {
+        for (int c = col - 1; c <= col + 1; c++) {
+            if (m_maze.isWall(r, c)) { // o celula deja spulberata de alta bomba din acelasi tick nu se mai numara
+                m_removedWalls.emplace_back(r, c);
+            }
+        }
+    }
+    m_maze.createHole(row, col);
+    m_players[player].setHasBomb(false);
+    m_hash ^= Zobrist::hasBomb(player);
+}
+
+void Arena::tick() {
+    if (isFinished()) {
+        return;
+    }
+
+    const int players = (int) m_players.size();
+    m_removedApples.clear();
+    m_removedWalls.clear();
+
+    for (int player = 0; player < players; player++) {
+        if (!m_inputs[player].tryPop(m_actions[player])) {
+            m_actions[player] = 0;
+        }
+        move(player, m_actions[player]);
+    }
+
+    const int first = (int) (m_ticks % (std::uint64_t) players);
+    for (int i = 0; i < players; i++) {
+        const int player = (first + i) % players;
+        if (m_actions[player] != rlutil::KEY_SPACE) {
+            continue;
+        }
+
+        const auto [row, col] = m_players[player].getPosition();
+        std::uint8_t &apple = m_apple[cellIndex(row, col)];
+        if (apple) {
+            apple = 0;
+            --m_applesLeft;
+            ++m_scores[player];
+            m_removedApples.emplace_back(row, col);
+            m_hash ^= Zobrist::cell(Zobrist::Feature::Apple, m_dim, row, col);
+        }
+        if (row == 0 && col == m_bombCol) {
+            m_hash ^= Zobrist::bomb(m_bombCol);
+            if (!m_players[player].getHasBomb()) {
+                m_hash ^= Zobrist::hasBomb(player);
+            }
+            m_players[player].setHasBomb(true);
+            m_bombCol = -1;
+            m_bombRespawnIn = m_bombRespawnTicks;
+        }
+    }
+
+    for (int player = 0; player < players; player++) {
+        if (m_actions[player] == 'f' && m_players[player].getHasBomb()) {
+            detonate(player);
+        }
+    }
+
+    if (m_bombCol < 0 && --m_bombRespawnIn <= 0) {
+        m_bombCol = std::uniform_int_distribution<int>{2, m_dim - 2}(m_rng);
+        m_hash ^= Zobrist::bomb(m_bombCol);
+    }
+
+    ++m_ticks;
+}
+
+bool Arena::isFinished() const {
+    return m_applesLeft == 0;
+}
+
+int Arena::winner() const {
+    if (!isFinished()) {
+        return -1;
+    }
+
+    int best = 0;
+    for (int player = 1; player < (int) m_scores.size(); player++) {
+        if (m_scores[player] > m_scores[best]) {
+            best = player;
+        }
+    }
+    return best;
+}
+
+std::uint64_t Arena::tickCount() const {
+    return m_ticks;
+}
+
+const Maze &Arena::getMaze() const {
+    return m_maze;
+}
+
+int Arena::playerCount() const {
+    return (int) m_players.size();
+}
+
+std::pair<int, int> Arena::playerPosition(const int player) const {
+    return m_players[player].getPosition();
+}
+
+bool Arena::playerHasBomb(const int player) const {
+    return m_players[player].getHasBomb();
+}
+
+int Arena::score(const int player) const {
+    return m_scores[player];
+}
+
+bool Arena::hasApple(const int row, const int col) const {
+    return m_apple[cellIndex(row, col)] != 0;
+}
+
+int Arena::applesLeft() const {
+    return m_applesLeft;
+}
+
+int Arena::bombColumn() const {
+    return m_bombCol;
+}
+
+const std::vector<std::pair<int, int>> &Arena::removedApples() const {
+    return m_removedApples;
+}
+
+const std::vector<std::pair<int, int>> &Arena::removedWalls() const {
+    return m_removedWalls;
+}
+
+void Arena::syncState(SyncState &state) const {
+    state.dim = m_dim;
+    state.wall.resize(m_apple.size());
+    for (int row = 0; row < m_dim; row++) {
+        for (int col = 0; col < m_dim; col++) {
+            state.wall[cellIndex(row, col)] = m_maze.isWall(row, col);
+        }
+    }
+    state.apple = m_apple;
+    state.bombCol = m_bombCol;
+
+    state.players.resize(m_players.size());
+    for (std::size_t i = 0; i < m_players.size(); i++) {
+        const auto [row, col] = m_players[i].getPosition();
+        state.players[i] = SyncState::PlayerState{row, col, m_players[i].getHasBomb(), m_scores[i]};
+    }
+    state.hash = stateHash();
+}
+
+std::uint64_t Arena::stateHash() const {
+    return m_maze.getHash() ^ m_hash;
+}
+
+ArenaShard::ArenaShard(const std::chrono::microseconds tickPeriod) : m_tickPeriod(tickPeriod) {}
+
+ArenaShard::~ArenaShard() {
+    stop();
+}
+
+Arena &ArenaShard::addArena(const int mazeSize, const int players, const std::uint64_t seed) {
+    m_arenas.push_back(std::make_unique<Arena>(mazeSize, players, seed));
+    return *m_arenas.back();
+}
+
+void ArenaShard::setTickListener(TickListener listener) {
+    m_listener = std::move(listener);
+}
+
+void ArenaShard::start() {
+    if (m_running.exchange(true)) {
+        return;
+    }
+    m_thread = std::thread([this] { run(); });
+}
+
+void ArenaShard::stop() {
+    m_running.store(false);
+    if (m_thread.joinable()) {
+        m_thread.join();
+    }
+}
+
+void ArenaShard::run() {
+    using Clock = std::chrono::steady_clock;
+    auto next = Clock::now();
+
+    while (m_running.load(std::memory_order_relaxed)) {
+        const auto roundStart = Clock::now();
+        for (const auto &arena: m_arenas) {
+            if (arena->isFinished()) {
+                continue;
+            }
+            arena->tick();
+            if (m_listener) {
+                m_listener(*arena);
+            }
+        }
+
+        const std::int64_t roundNs = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - roundStart).count();
+        if (roundNs > m_maxRoundNs.load(std::memory_order_relaxed)) {
+            m_maxRoundNs.store(roundNs, std::memory_order_relaxed); // un singur scriitor, deci fara CAS
+        }
+        m_rounds.fetch_add(1, std::memory_order_relaxed);
+
+        // un tick intarziat nu se recupereaza in rafala, se reia ritmul de acum
+        next = std::max(next + m_tickPeriod, Clock::now());
+        std::this_thread::sleep_until(next);
+    }
+}
+
+std::uint64_t ArenaShard::rounds() const {
+    return m_rounds.load(std::memory_order_relaxed);
+}
+
+std::chrono::nanoseconds ArenaShard::maxRoundTime() const {
+    return std::chrono::nanoseconds(m_maxRoundNs.load(std::memory_order_relaxed));
+}
@@ -0,0 +1,429 @@
+#include "BigMaze.h"
+
+#include <algorithm>
+#include <deque>
+#include <fstream>
+#include <limits>
+#include <stdexcept>
+
+#include "PnmExport.h"
+#include "Sidewinder.h"
+#include "SplitMix64.h"
+
+namespace {
+    constexpr char magic[4] = {'N', 'I', 'T', 'B'};
+    constexpr std::uint8_t formatVersion = 1;
+    constexpr std::uint32_t unreached = std::numeric_limits<std::uint32_t>::max();
+    constexpr std::size_t bytesPerCell = 32; // zid, distanta, sursa sortata si coada BFS, cu rezerva
+
+    void writeU64(std::ostream &out, const std::uint64_t value) {
+        for (int i = 0; i < 8; i++) {
+            out.put((char) (value >> (8 * i) & 0xFF));
+        }
+    }
+
+    std::uint64_t readU64(std::istream &in) {
+        std::uint64_t value = 0;
+        for (int i = 0; i < 8; i++) {
+            value |= (std::uint64_t) (std::uint8_t) in.get() << (8 * i);
+        }
+        return value;
+    }
+
+    // numar uniform din [0, n); ca uniformInt, dar pe 64 de biti (numarul de celule libere trece de 2^31)
+    std::uint64_t uniformBelow(SplitMix64 &rng, const std::uint64_t n) {
+        const std::uint64_t threshold = (0 - n) % n;
+        std::uint64_t x = rng();
+        while (x < threshold) {
+            x = rng();
+        }
+        return x % n;
+    }
+
+    // liniile la care Sidewinder nu mai revine sunt impachetate si scrise; in memorie raman cel mult trei
+    class RowWriter {
+    public:
+        RowWriter(std::ostream &out, const int dim, const std::uint64_t seed, const int apples)
+                : m_out(out), m_dim(dim), m_appleRng(seed ^ 0xA5A5A5A5A5A5A5A5ULL), m_maxApples(apples) {}
+
+        void carve(const int row, const int col) {
+            while (row >= m_firstRow + (int) m_rows.size()) {
+                m_rows.emplace_back(m_dim, 1);
+            }
+            while (row > m_firstRow + 2) { // Sidewinder lucreaza pe liniile row - 1, row, row + 1
+                flushFront();
+            }
+            m_rows[row - m_firstRow][col] = 0;
+        }
+
+        void finish() {
+            while (m_firstRow < m_dim) {
+                if (m_rows.empty()) {
+                    m_rows.emplace_back(m_dim, 1);
+                }
+                flushFront();
+            }
+        }
+
+        [[nodiscard]] const std::vector<std::pair<int, int>> &apples() const { return m_apples; }
+
+    private:
+        void flushFront() {
+            const std::vector<std::uint8_t> &row = m_rows.front();
+            std::vector<char> packed((std::size_t) (m_dim + 7) / 8);
+            for (int col = 0; col < m_dim; col++) {
+                if (row[col]) {
+                    packed[col / 8] = (char) (packed[col / 8] | 1 << (col % 8));
+                }
+                else if (m_firstRow > 0) { // ca getFreeCells: merele nu stau pe prima linie
+                    sample(m_firstRow, col);
+                }
+            }
+            m_out.write(packed.data(), (std::streamsize) packed.size());
+            m_rows.pop_front();
+            ++m_firstRow;
+        }
+
+        void sample(const int row, const int col) {
+            ++m_freeSeen;
+            if ((int) m_apples.size() < m_maxApples) {
+                m_apples.emplace_back(row, col);
+                return;
+            }
+            const std::uint64_t slot = uniformBelow(m_appleRng, m_freeSeen);
+            if (slot < (std::uint64_t) m_maxApples) {
+                m_apples[slot] = {row, col};
+            }
+        }
+
+        std::ostream &m_out;
+        int m_dim;
+        int m_firstRow = 0;
+        std::deque<std::vector<std::uint8_t>> m_rows;
+        SplitMix64 m_appleRng; // separat de generatorul labirintului, ca labirintul sa ramana cel din Maze
+        int m_maxApples;
+        std::uint64_t m_freeSeen = 0;
+        std::vector<std::pair<int, int>> m_apples;
+    };
+}
+
+void BigMaze::generate(const std::filesystem::path &path, const int dim, const std::uint64_t seed, const int apples) {
+    if (dim < 4 || apples < 0) {
+        throw std::invalid_argument("invalid maze size or apple count");
+    }
+
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out) {
+        throw std::runtime_error("cannot create " + path.string());
+    }
+
+    // antetul are loc pentru toate merele; se completeaza dupa ce sunt alese
+    const std::uint64_t headerSize = sizeof(magic) + 1 + 8 * 4 + 8 * (std::uint64_t) apples;
+    out.write(std::string(headerSize, '\0').data(), (std::streamsize) headerSize);
+
+    RowWriter writer{out, dim, seed, apples};
+    SplitMix64 rng{seed};
+    carveSidewinder(dim,
+                    [&rng](const int from, const int to) { return uniformInt(rng, from, to); },
+                    [&writer](const int row, const int col) { writer.carve(row, col); });
+    writer.finish();
+
+    out.seekp(0);
+    out.write(magic, sizeof(magic));
+    out.put((char) formatVersion);
+    writeU64(out, (std::uint64_t) dim);
+    writeU64(out, seed);
+    writeU64(out, (std::uint64_t) apples);
+    writeU64(out, writer.apples().size());
+    for (const auto &[row, col]: writer.apples()) {
+        writeU64(out, (std::uint64_t) row << 32 | (std::uint32_t) col);
+    }
+    if (!out) {
+        throw std::runtime_error("cannot write " + path.string());
+    }
+}
+
+BigMaze::BigMaze(std::filesystem::path path) : m_path(std::move(path)) {
+    std::ifstream in(m_path, std::ios::binary);
+    char header[sizeof(magic)] = {};
+    in.read(header, sizeof(header));
+    if (!in || !std::equal(magic, magic + sizeof(magic), header) || in.get() != formatVersion) {
+        throw std::runtime_error(m_path.string() + " is not a maze file");
+    }
+
+    const std::uint64_t dim = readU64(in);
+    m_seed = readU64(in);
+    const std::uint64_t slots = readU64(in);
+    const std::uint64_t apples = readU64(in);
+    if (!in || dim < 4 || dim > (std::uint64_t) std::numeric_limits<int>::max() || apples > slots ||
+        slots > dim * dim) {
+        throw std::runtime_error(m_path.string() + " has an invalid header");
+    }
+    m_dim = (int) dim;
+    for (std::uint64_t i = 0; i < apples; i++) {
+        const std::uint64_t packed = readU64(in);
+        m_apples.emplace_back((int) (packed >> 32), (int) (std::uint32_t) packed);
+    }
+    m_rowsOffset = (std::uint64_t) in.tellg() + 8 * (slots - apples);
+
+    if (!in || std::filesystem::file_size(m_path) != m_rowsOffset + rowBytes() * dim) {
+        throw std::runtime_error(m_path.string() + " is truncated");
+    }
+}
+
+std::uint64_t BigMaze::rowBytes() const {
+    return ((std::uint64_t) m_dim + 7) / 8;
+}
+
+void BigMaze::readRows(const int row, const int count, std::vector<std::uint8_t> &cells) const {
+    std::ifstream in(m_path, std::ios::binary);
+    in.seekg((std::streamoff) (m_rowsOffset + rowBytes() * row));
+    std::vector<char> packed(rowBytes() * count);
+    in.read(packed.data(), (std::streamsize) packed.size());
+    if (!in) {
+        throw std::runtime_error("cannot read " + m_path.string());
+    }
+
+    cells.resize((std::size_t) count * m_dim);
+    for (int r = 0; r < count; r++) {
+        unpackRow(packed.data() + rowBytes() * r, cells.data() + (std::size_t) r * m_dim);
+    }
+}
+
+void BigMaze::unpackRow(const char *packed, std::uint8_t *cells) const {
+    for (int col = 0; col < m_dim; col++) {
+        cells[col] = (std::uint8_t) (packed[col / 8] >> (col % 8) & 1);
+    }
+}
+
+void BigMaze::writePbm(std::ostream &out) const {
+    std::ifstream in(m_path, std::ios::binary);
+    in.seekg((std::streamoff) m_rowsOffset);
+    PnmWriter writer{out, m_dim, m_dim, PnmWriter::Format::Bitmap};
+    std::vector<char> packed(rowBytes());
+    std::vector<std::uint8_t> row((std::size_t) m_dim);
+    for (int r = 0; r < m_dim; r++) {
+        if (!in.read(packed.data(), (std::streamsize) packed.size())) {
+            throw std::runtime_error("cannot read " + m_path.string());
+        }
+        unpackRow(packed.data(), row.data());
+        writer.writeRow(row.data());
+    }
+}
+
+void BigMaze::writeHeatmap(const std::filesystem::path &distances, std::ostream &out) const {
+    const std::uint64_t rowDistanceBytes = (std::uint64_t) m_dim * sizeof(std::uint32_t);
+    if (!std::filesystem::exists(distances) || std::filesystem::file_size(distances) != rowDistanceBytes * m_dim) {
+        throw std::runtime_error(distances.string() + " does not hold the distances of this maze");
+    }
+
+    std::vector<std::uint32_t> distance((std::size_t) m_dim);
+    const auto readDistances = [&](std::ifstream &in) {
+        if (!in.read(reinterpret_cast<char *>(distance.data()), (std::streamsize) rowDistanceBytes)) {
+            throw std::runtime_error("cannot read " + distances.string());
+        }
+    };
+
+    // prima trecere doar pentru distanta maxima, de care depinde scala de gri
+    std::uint32_t maxDistance = 0;
+    {
+        std::ifstream in(distances, std::ios::binary);
+        for (int r = 0; r < m_dim; r++) {
+            readDistances(in);
+            for (const std::uint32_t d: distance) {
+                if (d != unreached) {
+                    maxDistance = std::max(maxDistance, d);
+                }
+            }
+        }
+    }
+
+    std::ifstream walls(m_path, std::ios::binary), in(distances, std::ios::binary);
+    walls.seekg((std::streamoff) m_rowsOffset);
+    PnmWriter writer{out, m_dim, m_dim, PnmWriter::Format::Graymap};
+    std::vector<char> packed(rowBytes());
+    std::vector<std::uint8_t> row((std::size_t) m_dim);
+    for (int r = 0; r < m_dim; r++) {
+        if (!walls.read(packed.data(), (std::streamsize) packed.size())) {
+            throw std::runtime_error("cannot read " + m_path.string());
+        }
+        readDistances(in);
+        unpackRow(packed.data(), row.data());
+        for (int col = 0; col < m_dim; col++) {
+            row[col] = row[col] ? Heatmap::wall
+                     : distance[col] == unreached ? Heatmap::unreachable : Heatmap::shade(distance[col], maxDistance);
+        }
+        writer.writeRow(row.data());
+    }
+}
+
+BigMaze::Solution BigMaze::solve(const std::filesystem::path &distances, const std::size_t memoryBudget) const {
+    Solution solution;
+    solution.apples = (int) m_apples.size();
+    // o banda are si cate o linie in plus deasupra si dedesubt
+    solution.bandRows = (int) std::clamp<std::uint64_t>(memoryBudget / ((std::uint64_t) m_dim * bytesPerCell), 1,
+                                                        (std::uint64_t) m_dim);
+    const int bandCount = (m_dim + solution.bandRows - 1) / solution.bandRows;
+    const std::uint64_t rowDistanceBytes = (std::uint64_t) m_dim * sizeof(std::uint32_t);
+
+    std::fstream dist(distances, std::ios::binary | std::ios::in | std::ios::out | std::ios::trunc);
+    if (!dist) {
+        throw std::runtime_error("cannot create " + distances.string());
+    }
+    {
+        std::vector<std::uint32_t> row((std::size_t) m_dim, unreached);
+        for (int r = 0; r < m_dim; r++) {
+            if (r == 0) {
+                row[0] = 0; // prima linie este libera, deci si iesirea
+            }
+            dist.write(reinterpret_cast<const char *>(row.data()), (std::streamsize) rowDistanceBytes);
+            row[0] = unreached;
+        }
+        solution.bytesWritten += rowDistanceBytes * m_dim;
+    }
+
+    std::vector<std::uint8_t> wall;
+    std::vector<std::uint32_t> distance;
+    std::vector<std::pair<std::uint32_t, std::uint32_t>> sources; // (distanta, index in banda)
+    std::vector<std::uint32_t> frontier;
+
+    // o banda se reia doar cand o banda vecina i-a imbunatatit linia de la margine; la prima vizita sursele sunt
+    // toate celulele atinse, apoi doar liniile vecine (restul benzii era deja relaxat)
+    std::vector<char> dirty((std::size_t) bandCount, 0), visited((std::size_t) bandCount, 0);
+    std::vector<std::uint64_t> reached((std::size_t) bandCount, 0);
+    dirty[0] = 1;
+
+    for (int sweep = 0; std::find(dirty.begin(), dirty.end(), 1) != dirty.end(); sweep++) {
+        for (int step = 0; step < bandCount; step++) {
+            const int band = sweep % 2 == 0 ? step : bandCount - 1 - step;
+            if (!dirty[band]) {
+                continue;
+            }
+            dirty[band] = 0;
+
+            const int firstRow = band * solution.bandRows;
+            const int lastRow = std::min(m_dim, firstRow + solution.bandRows); // exclusiv
+            const int top = std::max(0, firstRow - 1); // cu liniile vecine
+            const int bottom = std::min(m_dim, lastRow + 1);
+            const int rows = bottom - top;
+
+            readRows(top, rows, wall);
+            distance.resize((std::size_t) rows * m_dim);
+            dist.seekg((std::streamoff) (rowDistanceBytes * top));
+            dist.read(reinterpret_cast<char *>(distance.data()), (std::streamsize) (rowDistanceBytes * rows));
+            solution.bytesRead += (rowBytes() + rowDistanceBytes) * rows;
+
+            // BFS cu mai multe surse, fiecare cu distanta ei: sursele sortate se intercaleaza cu coada
+            sources.clear();
+            for (int row = top; row < bottom; row++) {
+                if (visited[band] && row >= firstRow && row < lastRow) {
+                    continue;
+                }
+                for (std::uint32_t cell = (std::uint32_t) (row - top) * m_dim, end = cell + m_dim; cell < end; cell++) {
+                    if (distance[cell] != unreached) {
+                        sources.emplace_back(distance[cell], cell);
+                    }
+                }
+            }
+            std::sort(sources.begin(), sources.end());
+            visited[band] = 1;
+
+            int changedFirst = m_dim, changedLast = -1;
+            frontier.clear();
+            std::size_t head = 0, nextSource = 0;
+            while (head < frontier.size() || nextSource < sources.size()) {
+                std::uint32_t cell;
+                if (head < frontier.size() &&
+                    (nextSource == sources.size() || distance[frontier[head]] <= sources[nextSource].first)) {
+                    cell = frontier[head++];
+                }
+                else {
+                    const auto [d, source] = sources[nextSource++];
+                    if (distance[source] != d) { // a fost deja imbunatatita de coada
+                        continue;
+                    }
+                    cell = source;
+                }
+
+                const int row = (int) (cell / m_dim), col = (int) (cell % m_dim);
+                if (distance[cell] == unreached - 1) {
+                    throw std::overflow_error("distance does not fit in 32 bits");
+                }
+                const std::uint32_t next = distance[cell] + 1;
+                const std::uint32_t neighbours[4] = {row > 0 ? cell - m_dim : cell, col > 0 ? cell - 1 : cell,
+                                                     row + 1 < rows ? cell + m_dim : cell,
+                                                     col + 1 < m_dim ? cell + 1 : cell};
+                for (const std::uint32_t neighbour: neighbours) {
+                    const int neighbourRow = top + (int) (neighbour / m_dim);
+                    // liniile vecine sunt doar surse; ele se actualizeaza cand le vine randul benzii lor
+                    if (neighbour == cell || wall[neighbour] || distance[neighbour] <= next ||
+                        neighbourRow < firstRow || neighbourRow >= lastRow) {
+                        continue;
+                    }
+                    distance[neighbour] = next;
+                    frontier.push_back(neighbour);
+                    changedFirst = std::min(changedFirst, neighbourRow);
+                    changedLast = std::max(changedLast, neighbourRow);
+                }
+            }
+
+            const std::size_t bandBegin = (std::size_t) (firstRow - top) * m_dim;
+            const std::size_t bandEnd = bandBegin + (std::size_t) (lastRow - firstRow) * m_dim;
+            reached[band] = (std::uint64_t) std::count_if(distance.begin() + (std::ptrdiff_t) bandBegin,
+                                                          distance.begin() + (std::ptrdiff_t) bandEnd,
+                                                          [](const std::uint32_t d) { return d != unreached; });
+            if (changedLast >= 0) {
+                dist.seekp((std::streamoff) (rowDistanceBytes * firstRow));
+                dist.write(reinterpret_cast<const char *>(distance.data() + bandBegin),
+                           (std::streamsize) ((bandEnd - bandBegin) * sizeof(std::uint32_t)));
+                solution.bytesWritten += (bandEnd - bandBegin) * sizeof(std::uint32_t);
+            }
+            if (band > 0 && changedFirst == firstRow) {
+                dirty[band - 1] = 1;
+            }
+            if (band + 1 < bandCount && changedLast == lastRow - 1) {
+                dirty[band + 1] = 1;
+            }
+        }
+        solution.sweeps = sweep + 1;
+    }
+    for (const std::uint64_t count: reached) {
+        solution.reachableCells += count;
+    }
+    if (!dist) {
+        throw std::runtime_error("cannot update " + distances.string());
+    }
+
+    const auto distanceAt = [&](const int row, const int col) {
+        std::uint32_t d = unreached;
+        dist.seekg((std::streamoff) (rowDistanceBytes * row + sizeof(std::uint32_t) * col));
+        dist.read(reinterpret_cast<char *>(&d), sizeof(d));
+        return d;
+    };
+
+    readRows(m_dim - 1, 1, wall);
+    for (int col = m_dim - 1; col >= 0; col--) {
+        if (!wall[col]) {
+            solution.goal = {m_dim - 1, col};
+            const std::uint32_t d = distanceAt(m_dim - 1, col);
+            solution.solutionLength = d == unreached ? -1 : (std::int64_t) d;
+            break;
+        }
+    }
+    for (const auto &[row, col]: m_apples) {
+        solution.reachableApples += distanceAt(row, col) != unreached;
+    }
+    return solution;
+}
+
+int BigMaze::getSize() const {
+    return m_dim;
+}
+
+std::uint64_t BigMaze::getSeed() const {
+    return m_seed;
+}
+
+const std::vector<std::pair<int, int>> &BigMaze::getApples() const {
+    return m_apples;
+}
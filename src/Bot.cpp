@@ -0,0 +1,398 @@
+#include "Bot.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <stdexcept>
+
+#include "Level.h"
+#include "LevelPipeline.h"
+#include "ThreadPool.h"
+
+namespace {
+    constexpr int keys[4] = {'w', 'a', 's', 'd'};
+}
+
+void BotGrid::assign(const Maze &maze) {
+    const int dim = maze.getSize();
+    m_stride = dim + 2;
+    m_offsets[0] = -m_stride;
+    m_offsets[1] = -1;
+    m_offsets[2] = m_stride;
+    m_offsets[3] = 1;
+    m_open.assign((std::size_t) m_stride * m_stride, 0);
+    for (int row = 0; row < dim; row++) {
+        for (int col = 0; col < dim; col++) {
+            m_open[cell(row, col)] = !maze.isWall(row, col);
+        }
+    }
+}
+
+std::int32_t BotGrid::cell(const int row, const int col) const {
+    return (row + 1) * m_stride + col + 1;
+}
+
+std::pair<int, int> BotGrid::position(const std::int32_t cell) const {
+    return {cell / m_stride - 1, cell % m_stride - 1};
+}
+
+bool BotGrid::isOpen(const std::int32_t cell) const {
+    return m_open[cell] != 0;
+}
+
+std::int32_t BotGrid::cellCount() const {
+    return (std::int32_t) m_open.size();
+}
+
+void BotGrid::distancesFrom(const std::int32_t source, std::vector<std::int32_t> &distance) {
+    distance.assign(m_open.size(), -1);
+    distance[source] = 0;
+    m_queue.resize(m_open.size());
+    m_queue[0] = source;
+    // fara ramificatii pe vecini: o celula noua este scrisa oricum la coada cozii, dar coada avanseaza doar daca
+    // celula este libera si nevizitata (altfel ramificatiile ar fi ghicite gresit la aproape fiecare vecin)
+    std::size_t tail = 1;
+    for (std::size_t head = 0; head < tail; head++) {
+        const std::int32_t current = m_queue[head];
+        const std::int32_t next = distance[current] + 1;
+        for (const std::int32_t offset: m_offsets) {
+            const std::int32_t neighbour = current + offset;
+            const bool discovered = m_open[neighbour] & (distance[neighbour] < 0);
+            distance[neighbour] = discovered ? next : distance[neighbour];
+            m_queue[tail] = neighbour;
+            tail += discovered;
+        }
+    }
+}
+
+int BotGrid::downhill(const std::int32_t cell, const std::vector<std::int32_t> &distance) const {
+    const std::int32_t here = distance[cell];
+    if (here <= 0) {
+        return 0;
+    }
+    for (int direction = 0; direction < 4; direction++) {
+        if (distance[cell + m_offsets[direction]] == here - 1) {
+            return keys[direction];
+        }
+    }
+    return 0;
+}
+
+std::unique_ptr<BotPolicy> BotPolicy::create(const std::string &name) {
+    if (name == "greedy") {
+        return std::make_unique<GreedyPolicy>();
+    }
+    if (name == "route") {
+        return std::make_unique<RoutePolicy>();
+    }
+    if (name == "bomb") {
+        return std::make_unique<BombAwarePolicy>();
+    }
+    throw std::invalid_argument("unknown bot policy " + name);
+}
+
+void GreedyPolicy::begin(const Game &game) {
+    buildTable(game);
+}
+
+void GreedyPolicy::buildTable(const Game &game) {
+    std::vector<std::pair<int, int>> targets{{0, 0}};
+    for (const Object &apple: game.getApples()) {
+        targets.push_back(apple.getPosition());
+    }
+    m_table = NextHopTable{game.getMaze(), targets};
+    m_tableWalls = game.getMaze().getHash();
+}
+
+int GreedyPolicy::nextKey(const Game &game) {
+    if (game.getMaze().getHash() != m_tableWalls) { // merele doar dispar, deci tabela tine cat timp tin peretii
+        buildTable(game);
+    }
+    const auto [row, col] = game.playerPosition();
+
+    if (game.applesLeft() == 0) { // spre iesire
+        const char key = NextHopTable::key(m_table.direction(row, col, 0, 0));
+        return key != 0 ? key : 'q';
+    }
+
+    const DistanceField &apples = game.appleDistances();
+    const std::int32_t distance = apples.distance(row, col);
+    if (distance == DistanceField::unreachable) {
+        return 'q';
+    }
+    if (distance == 0) {
+        return rlutil::KEY_SPACE;
+    }
+    const auto [appleRow, appleCol] = apples.nearestSource(row, col);
+    const char key = NextHopTable::key(m_table.direction(row, col, appleRow, appleCol));
+    return key != 0 ? key : 'q';
+}
+
+std::string GreedyPolicy::name() const {
+    return "greedy";
+}
+
+void RoutePolicy::begin(const Game &game) {
+    plan(game);
+}
+
+void RoutePolicy::plan(const Game &game) {
+    m_plannedWalls = game.getMaze().getHash();
+    m_grid.assign(game.getMaze());
+    const std::int32_t player = m_grid.cell(game.playerPosition().first, game.playerPosition().second);
+
+    // un camp de distante pentru fiecare mar accesibil; fara drum pana la jucator marul ramane pentru mai tarziu
+    m_route.clear();
+    std::vector<std::vector<std::int32_t>> fields(game.getApples().size());
+    std::size_t count = 0;
+    for (const Object &apple: game.getApples()) {
+        const auto [appleRow, appleCol] = apple.getPosition();
+        m_grid.distancesFrom(m_grid.cell(appleRow, appleCol), fields[count]);
+        if (fields[count][player] >= 0) {
+            m_route.emplace_back(appleRow, appleCol);
+            ++count;
+        }
+    }
+    m_next = 0;
+
+    std::vector<std::int32_t> between(count * count), fromPlayer(count), toExit(count);
+    for (std::size_t i = 0; i < count; i++) {
+        for (std::size_t j = 0; j < count; j++) {
+            between[i * count + j] = fields[i][m_grid.cell(m_route[j].first, m_route[j].second)];
+        }
+        fromPlayer[i] = fields[i][player];
+        toExit[i] = fields[i][m_grid.cell(0, 0)];
+    }
+
+    // cel mai apropiat vecin, pornind de la jucator
+    std::vector<std::size_t> order;
+    std::vector<std::uint8_t> used(count);
+    for (std::size_t step = 0; step < count; step++) {
+        std::size_t best = count;
+        for (std::size_t i = 0; i < count; i++) {
+            const std::int32_t distance = order.empty() ? fromPlayer[i] : between[order.back() * count + i];
+            if (!used[i] && (best == count ||
+                             distance < (order.empty() ? fromPlayer[best] : between[order.back() * count + best]))) {
+                best = i;
+            }
+        }
+        used[best] = 1;
+        order.push_back(best);
+    }
+
+    // 2-opt pe drumul jucator -> mere -> iesire: se inverseaza order[i..j] cat timp drumul se scurteaza
+    const auto edge = [&](const std::size_t position, const std::size_t apple, const bool before) {
+        if (before) { // muchia dinspre elementul dinaintea pozitiei
+            return position == 0 ? fromPlayer[apple] : between[order[position - 1] * count + apple];
+        }
+        return position + 1 == count ? toExit[apple] : between[apple * count + order[position + 1]];
+    };
+    bool improved = true;
+    for (int pass = 0; improved && pass < 16; pass++) {
+        improved = false;
+        for (std::size_t i = 0; i + 1 < count; i++) {
+            for (std::size_t j = i + 1; j < count; j++) {
+                const std::int32_t delta = edge(i, order[j], true) + edge(j, order[i], false) -
+                                           edge(i, order[i], true) - edge(j, order[j], false);
+                if (delta < 0) {
+                    std::reverse(order.begin() + (std::ptrdiff_t) i, order.begin() + (std::ptrdiff_t) j + 1);
+                    improved = true;
+                }
+            }
+        }
+    }
+
+    std::vector<std::pair<int, int>> route(count);
+    for (std::size_t i = 0; i < count; i++) {
+        route[i] = m_route[order[i]];
+    }
+    m_route = std::move(route);
+    buildTable(game);
+}
+
+void RoutePolicy::buildTable(const Game &game) {
+    std::vector<std::pair<int, int>> targets = m_route;
+    targets.emplace_back(0, 0);
+    m_table = NextHopTable{game.getMaze(), targets};
+}
+
+int RoutePolicy::nextKey(const Game &game) {
+    if (game.getMaze().getHash() != m_plannedWalls) { // labirintul s-a schimbat (bomba)
+        plan(game);
+    }
+
+    const auto [row, col] = game.playerPosition();
+    if (game.hasApple(row, col)) { // si merele de pe drum, nu doar cel urmarit
+        return rlutil::KEY_SPACE;
+    }
+    while (m_next < m_route.size() && !game.hasApple(m_route[m_next].first, m_route[m_next].second)) {
+        ++m_next;
+    }
+    if (m_next < m_route.size()) {
+        return NextHopTable::key(m_table.direction(row, col, m_route[m_next].first, m_route[m_next].second));
+    }
+    if (game.applesLeft() == 0) {
+        const char key = NextHopTable::key(m_table.direction(row, col, 0, 0));
+        return key != 0 ? key : 'q';
+    }
+    return stuck(game);
+}
+
+int RoutePolicy::stuck(const Game &) {
+    return 'q';
+}
+
+std::string RoutePolicy::name() const {
+    return "route";
+}
+
+void BombAwarePolicy::begin(const Game &game) {
+    RoutePolicy::begin(game);
+    m_blastCell = {-1, -1};
+    m_bombCol = -1;
+}
+
+int BombAwarePolicy::stuck(const Game &game) {
+    const std::pair<int, int> position = game.playerPosition();
+    const std::int32_t player = m_grid.cell(position.first, position.second);
+
+    if (game.playerHasBomb()) {
+        if (m_blastCell.first < 0 && !findBlastCell(game)) {
+            return 'q';
+        }
+        if (position == m_blastCell) {
+            m_blastCell = {-1, -1};
+            m_bombCol = -1; // peretii se schimba, deci si drumul pana la bomba; traseul il reface nextKey
+            return 'f';
+        }
+        return m_grid.downhill(player, m_toBlast);
+    }
+
+    const int bombCol = game.bombColumn();
+    if (bombCol < 0 || position == std::make_pair(0, bombCol)) { // bomba noua apare dupa cateva secunde
+        return rlutil::KEY_SPACE;
+    }
+    if (bombCol != m_bombCol) {
+        m_grid.distancesFrom(m_grid.cell(0, bombCol), m_toBomb);
+        m_bombCol = bombCol;
+    }
+    const int key = m_grid.downhill(player, m_toBomb);
+    return key != 0 ? key : 'q';
+}
+
+bool BombAwarePolicy::findBlastCell(const Game &game) {
+    const auto [row, col] = game.playerPosition();
+    const std::int32_t cells = m_grid.cellCount();
+
+    // componentele celulelor libere si cele in care au ramas mere
+    std::vector<std::int32_t> component(cells, -1);
+    int components = 0;
+    for (std::int32_t cell = 0; cell < cells; cell++) {
+        if (!m_grid.isOpen(cell) || component[cell] >= 0) {
+            continue;
+        }
+        std::vector<std::int32_t> &fill = m_toBlast; // refolosit ca memorie temporara
+        m_grid.distancesFrom(cell, fill);
+        for (std::int32_t other = cell; other < cells; other++) {
+            if (fill[other] >= 0) {
+                component[other] = components;
+            }
+        }
+        ++components;
+    }
+    std::vector<std::uint8_t> wanted(components);
+    for (const Object &apple: game.getApples()) {
+        wanted[component[m_grid.cell(apple.getPosition().first, apple.getPosition().second)]] = 1;
+    }
+    wanted[component[m_grid.cell(row, col)]] = 0;
+
+    // gaura de 3 x 3 din jurul celulei uneste zona jucatorului cu orice celula libera din ea sau lipita de ea
+    std::vector<std::int32_t> fromPlayer;
+    m_grid.distancesFrom(m_grid.cell(row, col), fromPlayer);
+    const int dim = game.getMaze().getSize();
+    int best = -1;
+    for (std::int32_t cell = 0; cell < cells; cell++) {
+        if (fromPlayer[cell] < 0 || (best >= 0 && fromPlayer[cell] >= fromPlayer[best])) {
+            continue;
+        }
+        const auto [r, c] = m_grid.position(cell);
+        for (int dr = -2; dr <= 2 && best != cell; dr++) {
+            for (int dc = -2; dc <= 2; dc++) {
+                const int nr = r + dr, nc = c + dc;
+                if ((std::abs(dr) < 2 || std::abs(dc) < 2) && nr >= 0 && nc >= 0 && nr < dim && nc < dim &&
+                    m_grid.isOpen(m_grid.cell(nr, nc)) && wanted[component[m_grid.cell(nr, nc)]]) {
+                    best = cell;
+                    break;
+                }
+            }
+        }
+    }
+    if (best < 0) {
+        return false;
+    }
+
+    m_blastCell = m_grid.position(best);
+    m_grid.distancesFrom(best, m_toBlast);
+    return true;
+}
+
+std::string BombAwarePolicy::name() const {
+    return "bomb";
+}
+
+double BotStats::gamesPerSecond() const {
+    return seconds > 0 ? games / seconds : 0;
+}
+
+double BotStats::winRate() const {
+    return games > 0 ? (double) wins / games : 0;
+}
+
+BotStats runBotGames(const std::string &policyName, const int mazeSize, const int games, const std::uint64_t seed,
+                     const std::chrono::milliseconds keyInterval) {
+    constexpr int gamesPerTask = 8; // un joc pe 30 x 30 dureaza sub o milisecunda, deci cateva pe task
+    const int tasks = (std::max(games, 0) + gamesPerTask - 1) / gamesPerTask;
+
+    // politicile se creeaza aici, inainte de jocuri: un nume gresit arunca inainte sa porneasca vreun task
+    std::vector<std::unique_ptr<BotPolicy>> policies;
+    for (int task = 0; task < tasks; task++) {
+        policies.push_back(BotPolicy::create(policyName));
+    }
+
+    const auto started = std::chrono::steady_clock::now();
+    BotStats stats = ThreadPool::shared().parallelReduce(
+            0, (std::int64_t) tasks, 1, BotStats{},
+            [&](const std::int64_t begin, const std::int64_t end) {
+                BotStats partial;
+                for (std::int64_t task = begin; task < end; task++) {
+                    BotPolicy &policy = *policies[task];
+                    const int last = std::min(games, (int) (task + 1) * gamesPerTask);
+                    for (int index = (int) task * gamesPerTask; index < last; index++) {
+                        // seed-uri diferite, derivate determinist din seed-ul comun, ca in LevelPipeline
+                        const Level level = Level::generate(mazeSize, seed ^ ((std::uint64_t) index * 0xD1B54A32D192ED03ULL));
+                        Game game{mazeSize};
+                        game.setRenderEnabled(false);
+                        Game::Clock::time_point now = Game::Clock::now();
+                        game.start(now, level, LevelPipeline::timeLimit(level));
+                        policy.begin(game);
+                        while (game.isRunning()) {
+                            const int key = policy.nextKey(game);
+                            now += keyInterval;
+                            game.step(now, key);
+                            ++partial.keys;
+                        }
+
+                        ++partial.games;
+                        partial.wins += game.isWon();
+                    }
+                }
+                return partial;
+            },
+            [](BotStats total, const BotStats &partial) {
+                total.games += partial.games;
+                total.wins += partial.wins;
+                total.keys += partial.keys;
+                return total;
+            });
+    stats.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+    return stats;
+}
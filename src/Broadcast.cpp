@@ -0,0 +1,108 @@
+#include "Broadcast.h"
+
+#include <algorithm>
+#include <cerrno>
+
+#include <sys/socket.h>
+#include <sys/uio.h>
+
+namespace {
+    constexpr int maxIovecs = 64; // cadre trimise intr-un singur apel sendmsg
+}
+
+Broadcast::Broadcast(const std::size_t maxQueuedBytes) : m_maxQueuedBytes(maxQueuedBytes) {}
+
+void Broadcast::add(Subscriber &subscriber) {
+    subscriber.waitingKeyframe = true;
+    m_subscribers.push_back(&subscriber);
+    m_needsKeyframe = true;
+}
+
+void Broadcast::remove(const Subscriber &subscriber) {
+    std::erase(m_subscribers, &subscriber);
+}
+
+void Broadcast::dropPending(Subscriber &subscriber) {
+    const bool partial = subscriber.offset > 0;
+    const std::size_t keep = partial ? 1 : 0;
+    subscriber.dropped += subscriber.queue.size() - keep;
+    subscriber.queue.erase(subscriber.queue.begin() + (std::ptrdiff_t) keep, subscriber.queue.end());
+    subscriber.queuedBytes = partial ? subscriber.queue.front()->size() - subscriber.offset : 0;
+}
+
+void Broadcast::publish(const SharedFrame &frame, const bool keyframe) {
+    if (keyframe) {
+        m_needsKeyframe = false;
+    }
+
+    for (Subscriber *const subscriber: m_subscribers) {
+        if (keyframe) {
+            // un keyframe inlocuieste tot ce era in asteptare, deci un abonat lent sare direct la starea curenta
+            if (subscriber->waitingKeyframe || subscriber->queuedBytes + frame->size() > m_maxQueuedBytes) {
+                dropPending(*subscriber);
+            }
+            subscriber->waitingKeyframe = false;
+        }
+        else if (subscriber->waitingKeyframe) {
+            ++subscriber->dropped;
+            continue;
+        }
+        else if (subscriber->queuedBytes + frame->size() > m_maxQueuedBytes) {
+            dropPending(*subscriber);
+            ++subscriber->dropped;
+            subscriber->waitingKeyframe = true;
+            m_needsKeyframe = true;
+            continue;
+        }
+
+        subscriber->queue.push_back(frame);
+        subscriber->queuedBytes += frame->size();
+    }
+}
+
+Broadcast::FlushResult Broadcast::flush(Subscriber &subscriber) {
+    while (!subscriber.queue.empty()) {
+        iovec iov[maxIovecs];
+        int count = 0;
+        for (const SharedFrame &frame: subscriber.queue) {
+            const std::size_t skip = count == 0 ? subscriber.offset : 0;
+            iov[count].iov_base = const_cast<std::uint8_t *>(frame->data() + skip); // sendmsg nu scrie in buffer
+            iov[count].iov_len = frame->size() - skip;
+            if (++count == maxIovecs) {
+                break;
+            }
+        }
+
+        msghdr message{};
+        message.msg_iov = iov;
+        message.msg_iovlen = (std::size_t) count;
+        ssize_t written = sendmsg(subscriber.fd, &message, MSG_NOSIGNAL);
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return errno == EAGAIN || errno == EWOULDBLOCK ? FlushResult::Pending : FlushResult::Failed;
+        }
+
+        subscriber.queuedBytes -= (std::size_t) written;
+        while (written > 0) {
+            const std::size_t left = subscriber.queue.front()->size() - subscriber.offset;
+            if ((std::size_t) written < left) {
+                subscriber.offset += (std::size_t) written;
+                break;
+            }
+            written -= (ssize_t) left;
+            subscriber.queue.pop_front();
+            subscriber.offset = 0;
+        }
+    }
+    return FlushResult::Done;
+}
+
+bool Broadcast::needsKeyframe() const {
+    return m_needsKeyframe;
+}
+
+const std::vector<Broadcast::Subscriber *> &Broadcast::subscribers() const {
+    return m_subscribers;
+}
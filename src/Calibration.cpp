@@ -0,0 +1,155 @@
+#include "Calibration.h"
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <stdexcept>
+#include <string>
+
+#include "Bot.h"
+#include "Game.h"
+#include "Level.h"
+#include "LevelPipeline.h"
+#include "SplitMix64.h"
+
+namespace {
+    constexpr double lost = std::numeric_limits<double>::infinity();
+
+    // GreedyPolicy care mai apasa si directii gresite
+    class SimulatedPlayer : public GreedyPolicy {
+    public:
+        SimulatedPlayer(const double mistakeRate, const std::uint64_t seed) : m_mistakeRate(mistakeRate), m_rng(seed) {}
+
+        int nextKey(const Game &game) override {
+            constexpr int directions[4] = {'w', 'a', 's', 'd'};
+            if (uniform() < m_mistakeRate) {
+                return directions[uniformInt(m_rng, 0, 3)];
+            }
+            return GreedyPolicy::nextKey(game);
+        }
+
+        double uniform() {
+            return (double) (m_rng() >> 11) * 0x1.0p-53; // [0, 1)
+        }
+
+    private:
+        double m_mistakeRate;
+        SplitMix64 m_rng;
+    };
+
+    struct Playthrough {
+        int parLength{}; // 0 daca nu s-a gasit un nivel jucabil
+        double seconds = lost; // cat a durat jocul castigat
+        std::uint64_t keys{};
+    };
+
+    Playthrough play(const CalibrationConfig &config, const int size, const std::uint64_t index) {
+        Playthrough result;
+        // acelasi nivel indiferent de celelalte dimensiuni din configuratie
+        const std::uint64_t seed = config.seed ^ ((std::uint64_t) size * 0x9E3779B97F4A7C15ULL);
+        Level level;
+        for (int attempt = 0; attempt < LevelPipeline::maxAttempts; attempt++) {
+            level = Level::generate(size, LevelPipeline::levelSeed(seed, index, attempt));
+            if (LevelPipeline::isPlayable(level)) {
+                break;
+            }
+        }
+        if (!LevelPipeline::isPlayable(level)) {
+            return result; // parLength 0: jocul nu intra in calibrare
+        }
+        result.parLength = level.parLength;
+
+        SimulatedPlayer player{config.mistakeRate, level.seed};
+        const auto keyInterval = std::chrono::duration_cast<Game::Clock::duration>(
+                config.fastestKey + (config.slowestKey - config.fastestKey) * player.uniform());
+        // limita doar opreste un jucator care s-ar invarti la nesfarsit; un joc normal nu se apropie de ea
+        const long long maxKeys = 50LL * level.parLength + 1000;
+        const auto timeLimit = std::chrono::ceil<std::chrono::seconds>(keyInterval * maxKeys);
+
+        Game game{size};
+        game.setRenderEnabled(false);
+        const Game::Clock::time_point started = Game::Clock::now();
+        Game::Clock::time_point now = started;
+        game.start(now, level, timeLimit);
+        player.begin(game);
+        while (game.isRunning()) {
+            const int key = player.nextKey(game);
+            now += keyInterval;
+            game.step(now, key);
+            ++result.keys;
+        }
+        if (game.isWon()) {
+            result.seconds = std::chrono::duration<double>(now - started).count();
+        }
+        return result;
+    }
+
+    DifficultyTable::Row fit(const CalibrationConfig &config, const int size, const std::vector<Playthrough> &games) {
+        std::vector<double> ratios;
+        ratios.reserve(games.size());
+        for (const Playthrough &game: games) {
+            if (game.parLength > 0) {
+                ratios.push_back(game.seconds / game.parLength);
+            }
+        }
+        if (ratios.empty()) {
+            throw std::runtime_error("no playable levels of size " + std::to_string(size));
+        }
+        std::sort(ratios.begin(), ratios.end());
+
+        // cea mai mica valoare pentru care targetWinRate din jocuri au raportul sub ea; daca prea multe jocuri au
+        // fost pierdute oricum, se ia cel mai mare raport al unui joc castigat
+        const auto needed = (std::size_t) std::ceil(config.targetWinRate * (double) ratios.size());
+        double secondsPerStep = ratios[std::max<std::size_t>(needed, 1) - 1];
+        if (std::isinf(secondsPerStep)) {
+            const auto finite = std::find(ratios.begin(), ratios.end(), lost);
+            secondsPerStep = finite == ratios.begin() ? 1.0 : *(finite - 1);
+        }
+
+        int wins = 0;
+        for (const Playthrough &game: games) {
+            Level par;
+            par.parLength = game.parLength;
+            wins += game.parLength > 0 && game.seconds <= (double) DifficultyTable::timeLimit(par, secondsPerStep).count();
+        }
+        return DifficultyTable::Row{size, secondsPerStep, config.targetWinRate, (double) wins / (double) ratios.size(),
+                                    (int) ratios.size()};
+    }
+}
+
+CalibrationResult calibrate(const CalibrationConfig &config, ThreadPool &pool) {
+    if (config.sizes.empty() || config.games < 1 || !(config.targetWinRate > 0 && config.targetWinRate <= 1) ||
+        !(config.mistakeRate >= 0 && config.mistakeRate < 1) || config.fastestKey.count() <= 0 ||
+        config.slowestKey < config.fastestKey ||
+        std::any_of(config.sizes.begin(), config.sizes.end(), [](const int size) { return size < 10; })) {
+        throw std::invalid_argument("invalid calibration config");
+    }
+
+    // un nivel de 1000 x 1000 dureaza cat mii de niveluri mici, asa ca dimensiunile mari intra primele in pool
+    std::vector<int> sizes = config.sizes;
+    std::sort(sizes.begin(), sizes.end(), std::greater<>());
+    sizes.erase(std::unique(sizes.begin(), sizes.end()), sizes.end());
+    const auto games = (std::size_t) config.games;
+
+    const auto started = std::chrono::steady_clock::now();
+    std::vector<Playthrough> results(sizes.size() * games);
+    pool.parallelFor(0, (std::int64_t) results.size(), 1, [&](const std::int64_t begin, const std::int64_t end) {
+        for (std::int64_t task = begin; task < end; task++) {
+            results[task] = play(config, sizes[(std::size_t) task / games], (std::uint64_t) task % games);
+        }
+    });
+
+    CalibrationResult result;
+    for (std::size_t i = 0; i < sizes.size(); i++) {
+        const std::vector<Playthrough> sizeResults(results.begin() + (std::ptrdiff_t) (i * games),
+                                                   results.begin() + (std::ptrdiff_t) ((i + 1) * games));
+        result.table.setRow(fit(config, sizes[i], sizeResults));
+        for (const Playthrough &game: sizeResults) {
+            result.keys += game.keys;
+        }
+    }
+    result.games = (int) results.size();
+    result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+    return result;
+}
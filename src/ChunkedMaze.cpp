@@ -0,0 +1,169 @@
+#include "ChunkedMaze.h"
+
+#include <algorithm>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <system_error>
+
+#include "FixedMaze.h"
+#include "SplitMix64.h"
+#include "Varint.h"
+
+namespace {
+    int floorDiv(const int value, const int divisor) {
+        return value >= 0 ? value / divisor : -((-(value + 1)) / divisor) - 1;
+    }
+}
+
+ChunkedMaze::ChunkedMaze(const std::uint64_t worldSeed, std::filesystem::path directory, const std::size_t maxChunks)
+        : m_worldSeed(worldSeed), m_directory(std::move(directory)), m_maxChunks(std::max<std::size_t>(maxChunks, 9)) {
+    std::filesystem::create_directories(m_directory);
+}
+
+ChunkedMaze::~ChunkedMaze() {
+    flush();
+}
+
+std::size_t ChunkedMaze::KeyHash::operator()(const Key &key) const {
+    return (std::size_t) SplitMix64{(std::uint64_t) (std::uint32_t) key.first << 32 | (std::uint32_t) key.second}();
+}
+
+std::uint64_t ChunkedMaze::chunkSeed(const std::uint64_t worldSeed, const int chunkRow, const int chunkCol) {
+    SplitMix64 rng{worldSeed ^ ((std::uint64_t) (std::uint32_t) chunkRow << 32 | (std::uint32_t) chunkCol)};
+    return rng();
+}
+
+std::filesystem::path ChunkedMaze::chunkPath(const Key &key) const {
+    return m_directory / (std::to_string(m_worldSeed) + '_' + std::to_string(key.first) + '_' + std::to_string(key.second));
+}
+
+ChunkedMaze::Chunk &ChunkedMaze::chunkAt(const int row, const int col) {
+    const Key key{floorDiv(row, chunkSize), floorDiv(col, chunkSize)};
+    if (m_last != nullptr && key == m_lastKey) {
+        return *m_last;
+    }
+
+    auto it = m_chunks.find(key);
+    if (it != m_chunks.end()) {
+        m_lru.splice(m_lru.begin(), m_lru, it->second.lru);
+    }
+    else {
+        Chunk chunk;
+        std::ifstream in(chunkPath(key), std::ios::binary);
+        const std::vector<std::uint8_t> data((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+        std::size_t pos = 0;
+        chunk.wall.resize((std::size_t) chunkSize * chunkSize);
+        if (in && readBitset(data, pos, chunk.wall) && pos == data.size()) {
+            chunk.modified = false; // este deja pe disc
+            ++m_stats.loaded;
+        }
+        else {
+            FixedMaze<chunkSize, chunkSize> maze;
+            maze.generate(chunkSeed(m_worldSeed, key.first, key.second));
+            chunk.wall = maze.walls();
+            ++m_stats.generated;
+        }
+
+        m_lru.push_front(key);
+        chunk.lru = m_lru.begin();
+        it = m_chunks.emplace(key, std::move(chunk)).first;
+
+        if (m_chunks.size() > m_maxChunks) { // chunk-ul nou este in fata, deci nu poate fi el cel eliminat
+            const Key coldest = m_lru.back();
+            const auto victim = m_chunks.find(coldest);
+            if (victim->second.modified) {
+                save(coldest, victim->second);
+            }
+            m_chunks.erase(victim);
+            m_lru.pop_back();
+            ++m_stats.evicted;
+        }
+    }
+
+    m_lastKey = key;
+    m_last = &it->second; // referintele din unordered_map raman valide la inserari
+    return *m_last;
+}
+
+void ChunkedMaze::save(const Key &key, const Chunk &chunk) {
+    std::vector<std::uint8_t> data;
+    writeBitset(data, chunk.wall);
+
+    // fisier temporar si redenumire, ca o oprire in timpul scrierii sa nu lase un chunk pe jumatate
+    const std::filesystem::path path = chunkPath(key);
+    const std::filesystem::path temporary = path.string() + ".tmp";
+    {
+        std::ofstream out(temporary, std::ios::binary | std::ios::trunc);
+        out.write(reinterpret_cast<const char *>(data.data()), (std::streamsize) data.size());
+        if (!out) {
+            return;
+        }
+    }
+    std::error_code error;
+    std::filesystem::rename(temporary, path, error);
+    if (!error) {
+        ++m_stats.saved;
+    }
+}
+
+bool ChunkedMaze::isWall(const int row, const int col) {
+    const Chunk &chunk = chunkAt(row, col);
+    const int localRow = row - floorDiv(row, chunkSize) * chunkSize;
+    const int localCol = col - floorDiv(col, chunkSize) * chunkSize;
+    return chunk.wall[(std::size_t) localRow * chunkSize + localCol];
+}
+
+bool ChunkedMaze::isPositionAvailable(const int row, const int col) {
+    return !isWall(row, col);
+}
+
+void ChunkedMaze::createHole(const int row, const int col) {
+    for (int dr = -1; dr <= 1; dr++) {
+        for (int dc = -1; dc <= 1; dc++) {
+            if (dr == 0 && dc == 0) {
+                continue;
+            }
+            Chunk &chunk = chunkAt(row + dr, col + dc);
+            const int localRow = row + dr - floorDiv(row + dr, chunkSize) * chunkSize;
+            const int localCol = col + dc - floorDiv(col + dc, chunkSize) * chunkSize;
+            std::uint8_t &cell = chunk.wall[(std::size_t) localRow * chunkSize + localCol];
+            if (cell) {
+                cell = 0;
+                chunk.modified = true;
+            }
+        }
+    }
+}
+
+void ChunkedMaze::prefetch(const int row, const int col, const int radius) {
+    const Key key{floorDiv(row, chunkSize), floorDiv(col, chunkSize)};
+    if (key == m_prefetchedKey && radius <= m_prefetchedRadius) { // de obicei jucatorul nu a iesit din chunk
+        return;
+    }
+    m_prefetchedKey = key;
+    m_prefetchedRadius = radius;
+
+    for (int dr = -radius; dr <= radius; dr++) {
+        for (int dc = -radius; dc <= radius; dc++) {
+            chunkAt(row + dr * chunkSize, col + dc * chunkSize);
+        }
+    }
+}
+
+void ChunkedMaze::flush() {
+    for (auto &[key, chunk]: m_chunks) {
+        if (chunk.modified) {
+            save(key, chunk);
+            chunk.modified = false;
+        }
+    }
+}
+
+std::size_t ChunkedMaze::residentChunks() const {
+    return m_chunks.size();
+}
+
+ChunkedMaze::Stats ChunkedMaze::stats() const {
+    return m_stats;
+}
@@ -0,0 +1,436 @@
+#include "CompressedMaze.h"
+
+#include <algorithm>
+#include <array>
+#include <string>
+#include <random.hpp>
+
+#include "Sidewinder.h"
+#include "SplitMix64.h"
+#include "Varint.h"
+#include "Zobrist.h"
+
+namespace {
+    enum class TileMode : std::uint8_t { Rle = 0, Context = 1 };
+
+    constexpr int probabilityBits = 11;
+    constexpr int adaptShift = 4; // tile-urile sunt mici, deci probabilitatile trebuie sa se adapteze repede
+    constexpr std::uint32_t topValue = 1U << 24;
+    constexpr int contextCount = 3 * 3 * 3 * 3 * 3 * 2;
+
+    using Model = std::array<std::uint16_t, contextCount>;
+
+    Model freshModel() {
+        Model model;
+        model.fill(1 << (probabilityBits - 1));
+        return model;
+    }
+
+    // Tile-ul cu o margine de valori 2 (in afara tile-ului sau inca necodat): doua randuri deasupra si cate o coloana
+    // in stanga si in dreapta, ca vecinii din context sa se citeasca fara verificari. Celula (row, col) este la
+    // (row + 2) * paddedWidth + col + 1; 0 = liber, 1 = zid.
+    constexpr int paddedWidth = CompressedMaze::tileSize + 2;
+    using PaddedTile = std::array<std::uint8_t, (CompressedMaze::tileSize + 2) * paddedWidth>;
+
+    int context(const std::uint8_t *cell, const int row) {
+        const int index = (((cell[-paddedWidth] * 3 + cell[-1]) * 3 + cell[-paddedWidth - 1]) * 3 +
+                           cell[-paddedWidth + 1]) * 3 + cell[-2 * paddedWidth];
+        return index * 2 + (row & 1); // tile-urile incep pe randuri pare, deci paritatea e si cea din labirint
+    }
+
+    // range coder binar ca in LZMA
+    class RangeEncoder {
+    public:
+        explicit RangeEncoder(std::vector<std::uint8_t> &out) : m_out(out) {}
+
+        void encode(std::uint16_t &probability, const int bit) {
+            const std::uint32_t bound = (m_range >> probabilityBits) * probability;
+            if (bit == 0) {
+                m_range = bound;
+                probability = (std::uint16_t) (probability + (((1 << probabilityBits) - probability) >> adaptShift));
+            }
+            else {
+                m_low += bound;
+                m_range -= bound;
+                probability = (std::uint16_t) (probability - (probability >> adaptShift));
+            }
+            while (m_range < topValue) {
+                m_range <<= 8;
+                shiftLow();
+            }
+        }
+
+        void finish() {
+            for (int i = 0; i < 5; i++) {
+                shiftLow();
+            }
+        }
+
+    private:
+        void shiftLow() {
+            if ((std::uint32_t) m_low < 0xFF000000U || (m_low >> 32) != 0) {
+                std::uint8_t carry = m_cache;
+                do {
+                    m_out.push_back((std::uint8_t) (carry + (std::uint8_t) (m_low >> 32)));
+                    carry = 0xFF;
+                } while (--m_cacheSize != 0);
+                m_cache = (std::uint8_t) (m_low >> 24);
+            }
+            ++m_cacheSize;
+            m_low = (m_low & 0x00FFFFFFU) << 8;
+        }
+
+        std::vector<std::uint8_t> &m_out;
+        std::uint64_t m_low = 0;
+        std::uint32_t m_range = 0xFFFFFFFFU;
+        std::uint8_t m_cache = 0;
+        std::uint64_t m_cacheSize = 1;
+    };
+
+    class RangeDecoder {
+    public:
+        RangeDecoder(const std::vector<std::uint8_t> &in, const std::size_t pos) : m_in(in), m_pos(pos) {
+            for (int i = 0; i < 5; i++) {
+                m_code = m_code << 8 | next();
+            }
+        }
+
+        int decode(std::uint16_t &probability) {
+            const std::uint32_t bound = (m_range >> probabilityBits) * probability;
+            int bit;
+            if (m_code < bound) {
+                m_range = bound;
+                probability = (std::uint16_t) (probability + (((1 << probabilityBits) - probability) >> adaptShift));
+                bit = 0;
+            }
+            else {
+                m_code -= bound;
+                m_range -= bound;
+                probability = (std::uint16_t) (probability - (probability >> adaptShift));
+                bit = 1;
+            }
+            if (m_range < topValue) {
+                m_range <<= 8;
+                m_code = m_code << 8 | next();
+            }
+            return bit;
+        }
+
+    private:
+        std::uint32_t next() { return m_pos < m_in.size() ? m_in[m_pos++] : 0; }
+
+        const std::vector<std::uint8_t> &m_in;
+        std::size_t m_pos;
+        std::uint32_t m_code = 0;
+        std::uint32_t m_range = 0xFFFFFFFFU;
+    };
+
+    void encodeRle(const std::uint8_t *cells, const int stride, const int rows, const int cols,
+                   std::vector<std::uint8_t> &out) {
+        out.push_back((std::uint8_t) TileMode::Rle);
+        std::uint8_t current = 1; // prima secventa este de ziduri, eventual goala
+        std::uint64_t run = 0;
+        for (int row = 0; row < rows; row++) {
+            for (int col = 0; col < cols; col++) {
+                if ((cells[(std::size_t) row * stride + col] != 0) != (current != 0)) {
+                    writeVarint(out, run);
+                    current ^= 1;
+                    run = 0;
+                }
+                ++run;
+            }
+        }
+        writeVarint(out, run);
+    }
+
+    void encodeContext(const std::uint8_t *cells, const int stride, const int rows, const int cols,
+                       std::vector<std::uint8_t> &out) {
+        out.push_back((std::uint8_t) TileMode::Context);
+        PaddedTile padded;
+        padded.fill(2);
+        for (int row = 0; row < rows; row++) {
+            for (int col = 0; col < cols; col++) {
+                padded[(row + 2) * paddedWidth + col + 1] = cells[(std::size_t) row * stride + col] != 0;
+            }
+        }
+
+        Model model = freshModel();
+        RangeEncoder encoder{out};
+        for (int row = 0; row < rows; row++) {
+            const std::uint8_t *cell = padded.data() + (row + 2) * paddedWidth + 1;
+            for (int col = 0; col < cols; col++, cell++) {
+                encoder.encode(model[context(cell, row)], *cell);
+            }
+        }
+        encoder.finish();
+    }
+}
+
+CompressedMaze::CompressedMaze(const int dim, const std::size_t cacheTiles)
+        : m_dim(dim), m_tilesPerRow((dim + tileSize - 1) / tileSize), m_cache(std::max<std::size_t>(cacheTiles, 1)) {
+    for (CachedTile &slot: m_cache) {
+        slot.wall.resize((std::size_t) tileSize * tileSize);
+    }
+    m_tiles.resize((std::size_t) m_tilesPerRow * m_tilesPerRow);
+    for (int tile = 0; tile < (int) m_tiles.size(); tile++) { // numai ziduri: o singura secventa
+        m_tiles[tile].push_back((std::uint8_t) TileMode::Rle);
+        writeVarint(m_tiles[tile], (std::uint64_t) tileRows(tile / m_tilesPerRow) * tileCols(tile % m_tilesPerRow));
+        m_compressedBytes += m_tiles[tile].size();
+    }
+    m_hash = computeHash();
+}
+
+bool CompressedMaze::isInside(const int row, const int col) const {
+    return row >= 0 && col >= 0 && row < m_dim && col < m_dim;
+}
+
+int CompressedMaze::tileRows(const int tileRow) const {
+    return std::min(tileSize, m_dim - tileRow * tileSize);
+}
+
+int CompressedMaze::tileCols(const int tileCol) const {
+    return std::min(tileSize, m_dim - tileCol * tileSize);
+}
+
+void CompressedMaze::store(const int tile, const std::uint8_t *cells, const int stride) const {
+    const int rows = tileRows(tile / m_tilesPerRow), cols = tileCols(tile % m_tilesPerRow);
+    std::vector<std::uint8_t> context, rle;
+    encodeContext(cells, stride, rows, cols, context);
+    encodeRle(cells, stride, rows, cols, rle);
+
+    std::vector<std::uint8_t> &data = m_tiles[tile];
+    m_compressedBytes -= data.size();
+    data = rle.size() <= context.size() ? std::move(rle) : std::move(context);
+    data.shrink_to_fit();
+    m_compressedBytes += data.size();
+}
+
+void CompressedMaze::decode(const int tile, std::uint8_t *cells) const {
+    for (const CachedTile &slot: m_cache) {
+        if (slot.tile == tile) {
+            std::copy(slot.wall.begin(), slot.wall.end(), cells);
+            return;
+        }
+    }
+
+    const int rows = tileRows(tile / m_tilesPerRow), cols = tileCols(tile % m_tilesPerRow);
+    const std::vector<std::uint8_t> &data = m_tiles[tile];
+    if ((TileMode) data[0] == TileMode::Rle) {
+        std::size_t pos = 1;
+        std::uint64_t run = 0;
+        std::uint8_t current = 0;
+        for (int row = 0; row < rows; row++) {
+            for (int col = 0; col < cols; col++) {
+                while (run == 0 && readVarint(data, pos, run)) {
+                    current ^= 1; // prima secventa este de ziduri
+                }
+                cells[row * tileSize + col] = current;
+                --run;
+            }
+        }
+        return;
+    }
+
+    PaddedTile padded;
+    padded.fill(2);
+    Model model = freshModel();
+    RangeDecoder decoder{data, 1};
+    for (int row = 0; row < rows; row++) {
+        std::uint8_t *cell = padded.data() + (row + 2) * paddedWidth + 1;
+        for (int col = 0; col < cols; col++, cell++) {
+            *cell = (std::uint8_t) decoder.decode(model[context(cell, row)]);
+        }
+        std::copy(cell - cols, cell, cells + row * tileSize);
+    }
+}
+
+CompressedMaze::CachedTile &CompressedMaze::cached(const int row, const int col) const {
+    const int tile = row / tileSize * m_tilesPerRow + col / tileSize;
+    if (m_lastSlot >= 0 && m_cache[m_lastSlot].tile == tile) {
+        ++m_stats.hits;
+        m_cache[m_lastSlot].lastUse = ++m_clock;
+        return m_cache[m_lastSlot];
+    }
+
+    int victimSlot = 0;
+    for (int slot = 0; slot < (int) m_cache.size(); slot++) {
+        if (m_cache[slot].tile == tile) {
+            ++m_stats.hits;
+            m_cache[slot].lastUse = ++m_clock;
+            m_lastSlot = slot;
+            return m_cache[slot];
+        }
+        if (m_cache[slot].lastUse < m_cache[victimSlot].lastUse) {
+            victimSlot = slot;
+        }
+    }
+
+    CachedTile *const victim = &m_cache[victimSlot];
+    if (victim->dirty) {
+        store(victim->tile, victim->wall.data(), tileSize);
+        ++m_stats.recompressed;
+    }
+    victim->tile = -1; // decode nu trebuie sa gaseasca tile-ul vechi in cache
+    decode(tile, victim->wall.data());
+    victim->tile = tile;
+    victim->dirty = false;
+    victim->lastUse = ++m_clock;
+    ++m_stats.misses;
+    m_lastSlot = victimSlot;
+    return *victim;
+}
+
+bool CompressedMaze::isWall(const int row, const int col) const {
+    return isInside(row, col) && cached(row, col).wall[(row % tileSize) * tileSize + col % tileSize] != 0;
+}
+
+bool CompressedMaze::isPositionAvailable(const int row, const int col) {
+    return isInside(row, col) && !isWall(row, col);
+}
+
+template<typename RandInt>
+void CompressedMaze::generateWith(RandInt &&randInt) {
+    for (CachedTile &slot: m_cache) {
+        slot = CachedTile{-1, std::move(slot.wall), false, 0};
+    }
+    m_lastSlot = -1;
+
+    // Sidewinder sapa doar pe randurile row - 1, row, row + 1, asa ca o banda de tile-uri este completa cand se
+    // ajunge la doua randuri sub ea; banda tine si aceste doua randuri
+    const int bandRows = tileSize + 2;
+    std::vector<std::uint8_t> band((std::size_t) bandRows * m_dim, 1);
+    int bandStart = 0;
+    const auto flushBand = [&]() {
+        const int tileRow = bandStart / tileSize;
+        for (int tileCol = 0; tileCol < m_tilesPerRow; tileCol++) {
+            store(tileRow * m_tilesPerRow + tileCol, band.data() + (std::size_t) tileCol * tileSize, m_dim);
+        }
+        std::copy(band.begin() + (std::ptrdiff_t) tileSize * m_dim, band.end(), band.begin());
+        std::fill(band.begin() + (std::ptrdiff_t) (bandRows - tileSize) * m_dim, band.end(), 1);
+        bandStart += tileSize;
+    };
+
+    carveSidewinder(m_dim, randInt, [&](const int row, const int col) {
+        while (row >= bandStart + bandRows) {
+            flushBand();
+        }
+        band[(std::size_t) (row - bandStart) * m_dim + col] = 0;
+    });
+    while (bandStart < m_dim) {
+        flushBand();
+    }
+    m_hash = computeHash();
+}
+
+void CompressedMaze::generate() {
+    generateWith([](const int from, const int to) { return effolkronium::random_static::get(from, to); });
+}
+
+void CompressedMaze::generate(const std::uint64_t seed) {
+    SplitMix64 rng{seed};
+    generateWith([&rng](const int from, const int to) { return uniformInt(rng, from, to); });
+}
+
+void CompressedMaze::assign(const std::vector<std::uint8_t> &wall) {
+    for (CachedTile &slot: m_cache) {
+        slot = CachedTile{-1, std::move(slot.wall), false, 0};
+    }
+    m_lastSlot = -1;
+    for (int tile = 0; tile < (int) m_tiles.size(); tile++) {
+        const std::size_t first = (std::size_t) (tile / m_tilesPerRow) * tileSize * m_dim +
+                                  (std::size_t) (tile % m_tilesPerRow) * tileSize;
+        store(tile, wall.data() + first, m_dim);
+    }
+    m_hash = computeHash();
+}
+
+void CompressedMaze::createHole(const int row, const int col) { // ca Maze::createHole
+    for (int dr = -1; dr <= 1; dr++) {
+        for (int dc = -1; dc <= 1; dc++) {
+            const int newRow = row + dr, newCol = col + dc;
+            if ((dr != 0 || dc != 0) && isWall(newRow, newCol)) {
+                CachedTile &tile = cached(newRow, newCol);
+                tile.wall[(newRow % tileSize) * tileSize + newCol % tileSize] = 0;
+                tile.dirty = true;
+                m_hash ^= Zobrist::cell(Zobrist::Feature::Wall, m_dim, newRow, newCol);
+            }
+        }
+    }
+}
+
+template<typename Visit>
+void CompressedMaze::forEachRow(Visit &&visit) const {
+    std::vector<std::uint8_t> tiles((std::size_t) m_tilesPerRow * tileSize * tileSize);
+    std::vector<std::uint8_t> row((std::size_t) m_dim);
+    for (int tileRow = 0; tileRow < m_tilesPerRow; tileRow++) {
+        for (int tileCol = 0; tileCol < m_tilesPerRow; tileCol++) {
+            decode(tileRow * m_tilesPerRow + tileCol, tiles.data() + (std::size_t) tileCol * tileSize * tileSize);
+        }
+        for (int r = 0; r < tileRows(tileRow); r++) {
+            for (int col = 0; col < m_dim; col++) {
+                row[col] = tiles[(std::size_t) (col / tileSize) * tileSize * tileSize + r * tileSize + col % tileSize];
+            }
+            visit(tileRow * tileSize + r, row.data());
+        }
+    }
+}
+
+std::vector<std::pair<int, int>> CompressedMaze::getFreeCells() {
+    std::vector<std::pair<int, int>> result;
+    forEachRow([&](const int row, const std::uint8_t *cells) {
+        for (int col = 0; row > 0 && col < m_dim; col++) {
+            if (!cells[col]) {
+                result.emplace_back(row, col);
+            }
+        }
+    });
+    return result;
+}
+
+void CompressedMaze::print(std::ostream &out) const {
+    std::string line((std::size_t) m_dim, ' ');
+    forEachRow([&](int, const std::uint8_t *cells) {
+        for (int col = 0; col < m_dim; col++) {
+            line[col] = cells[col] ? '#' : ' ';
+        }
+        out << line << std::endl;
+    });
+}
+
+int CompressedMaze::getSize() const {
+    return m_dim;
+}
+
+std::uint64_t CompressedMaze::getHash() const {
+    return m_hash;
+}
+
+std::uint64_t CompressedMaze::computeHash() const {
+    std::uint64_t hash = 0;
+    forEachRow([&](const int row, const std::uint8_t *cells) {
+        for (int col = 0; col < m_dim; col++) {
+            if (cells[col]) {
+                hash ^= Zobrist::cell(Zobrist::Feature::Wall, m_dim, row, col);
+            }
+        }
+    });
+    return hash;
+}
+
+void CompressedMaze::flush() {
+    for (CachedTile &slot: m_cache) {
+        if (slot.dirty) {
+            store(slot.tile, slot.wall.data(), tileSize);
+            slot.dirty = false;
+            ++m_stats.recompressed;
+        }
+    }
+}
+
+std::size_t CompressedMaze::compressedBytes() const {
+    return m_compressedBytes;
+}
+
+CompressedMaze::Stats CompressedMaze::stats() const {
+    return m_stats;
+}
@@ -0,0 +1,145 @@
+#include "DifficultyTable.h"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <csv.hpp>
+
+namespace {
+    std::string format(const double value, const int decimals) {
+        std::ostringstream out;
+        out.precision(decimals);
+        out << std::fixed << value;
+        return out.str();
+    }
+}
+
+DifficultyTable &DifficultyTable::shared() {
+    static DifficultyTable table;
+    return table;
+}
+
+DifficultyTable DifficultyTable::load(const std::string &path) {
+    std::ifstream file(path);
+    if (!file) {
+        throw std::runtime_error("cannot open difficulty table " + path);
+    }
+    try {
+        return readCsv(file);
+    }
+    catch (const std::runtime_error &e) {
+        throw std::runtime_error(path + ": " + e.what());
+    }
+}
+
+DifficultyTable DifficultyTable::readCsv(std::istream &in) {
+    // randurile cu mai putine coloane decat antetul (tabelele vechi, doar size si seconds_per_step) se pastreaza
+    csv::CSVFormat format;
+    format.delimiter(',').header_row(0).variable_columns(csv::VariableColumnPolicy::KEEP);
+    std::stringstream text; // CSVReader isi muta sursa, deci are nevoie de un stream concret
+    text << in.rdbuf();
+    csv::CSVReader reader(text, format);
+    const std::vector<std::string> columns = reader.get_col_names();
+    if (columns.size() < 2 || columns[0] != "size" || columns[1] != "seconds_per_step") {
+        throw std::runtime_error("missing difficulty table header");
+    }
+
+    DifficultyTable table;
+    int lineNumber = 1;
+    for (csv::CSVRow &fields: reader) {
+        ++lineNumber;
+        if (fields.size() == 0 || (fields.size() == 1 && fields[0].is_null())) { // rand gol
+            continue;
+        }
+        Row row;
+        try {
+            if (fields.size() < 2) {
+                throw std::runtime_error("too few fields");
+            }
+            row.size = fields[0].get<int>();
+            row.secondsPerStep = fields[1].get<double>();
+            if (fields.size() >= 5) {
+                row.targetWinRate = fields[2].get<double>();
+                row.winRate = fields[3].get<double>();
+                row.games = fields[4].get<int>();
+            }
+        }
+        catch (const std::runtime_error &) { // CSVField::get arunca pentru campuri care nu sunt numere sau nu incap
+            throw std::runtime_error("invalid row on line " + std::to_string(lineNumber));
+        }
+        if (row.size < 1 || !(row.secondsPerStep > 0) || !std::isfinite(row.secondsPerStep)) {
+            throw std::runtime_error("invalid row on line " + std::to_string(lineNumber));
+        }
+        table.setRow(row);
+    }
+    return table;
+}
+
+void DifficultyTable::save(const std::string &path) const {
+    std::ofstream file(path);
+    if (!file) {
+        throw std::runtime_error("cannot write difficulty table to " + path);
+    }
+    writeCsv(file);
+}
+
+void DifficultyTable::writeCsv(std::ostream &out) const {
+    auto writer = csv::make_csv_writer(out);
+    writer << std::vector<std::string>{"size", "seconds_per_step", "target_win_rate", "win_rate", "games"};
+    for (const Row &row: m_rows) {
+        writer << std::vector<std::string>{std::to_string(row.size), format(row.secondsPerStep, 4),
+                                           format(row.targetWinRate, 3), format(row.winRate, 3),
+                                           std::to_string(row.games)};
+    }
+}
+
+void DifficultyTable::setRow(const Row &row) {
+    const auto it = std::lower_bound(m_rows.begin(), m_rows.end(), row.size,
+                                     [](const Row &existing, const int size) { return existing.size < size; });
+    if (it != m_rows.end() && it->size == row.size) {
+        *it = row;
+    }
+    else {
+        m_rows.insert(it, row);
+    }
+}
+
+const std::vector<DifficultyTable::Row> &DifficultyTable::rows() const {
+    return m_rows;
+}
+
+bool DifficultyTable::empty() const {
+    return m_rows.empty();
+}
+
+double DifficultyTable::secondsPerStep(const int size) const {
+    const auto upper = std::lower_bound(m_rows.begin(), m_rows.end(), size,
+                                        [](const Row &row, const int value) { return row.size < value; });
+    if (upper == m_rows.begin()) {
+        return upper->secondsPerStep;
+    }
+    if (upper == m_rows.end()) {
+        return m_rows.back().secondsPerStep;
+    }
+    const Row &lower = *(upper - 1);
+    const double t = (double) (size - lower.size) / (upper->size - lower.size);
+    return lower.secondsPerStep + t * (upper->secondsPerStep - lower.secondsPerStep);
+}
+
+std::chrono::seconds DifficultyTable::timeLimit(const Level &level) const {
+    if (m_rows.empty()) {
+        return legacyTimeLimit(level.apples.size());
+    }
+    return timeLimit(level, secondsPerStep(level.dim));
+}
+
+std::chrono::seconds DifficultyTable::legacyTimeLimit(const std::size_t apples) {
+    return std::chrono::minutes(std::max<std::size_t>(apples / 10, 1));
+}
+
+std::chrono::seconds DifficultyTable::timeLimit(const Level &level, const double secondsPerStep) {
+    const auto seconds = (long long) std::ceil(secondsPerStep * level.parLength);
+    return std::chrono::seconds(std::max(minSeconds, seconds));
+}
@@ -0,0 +1,146 @@
+#include "DistanceField.h"
+
+#include <algorithm>
+
+void DistanceField::reset(const Maze &maze, const std::vector<std::pair<int, int>> &sources) {
+    m_dim = maze.getSize();
+    m_stride = m_dim + 2;
+    m_offsets[0] = -m_stride;
+    m_offsets[1] = -1;
+    m_offsets[2] = m_stride;
+    m_offsets[3] = 1;
+    m_open.assign((std::size_t) m_stride * m_stride, 0);
+    for (int row = 0; row < m_dim; row++) {
+        for (int col = 0; col < m_dim; col++) {
+            m_open[cell(row, col)] = !maze.isWall(row, col);
+        }
+    }
+    m_distance.assign(m_open.size(), infinity);
+    m_owner.assign(m_open.size(), -1);
+
+    m_seeds.clear();
+    for (const auto &[row, col]: sources) {
+        const std::int32_t source = cell(row, col);
+        m_distance[source] = 0;
+        m_owner[source] = source;
+        m_seeds.emplace_back(0, source);
+    }
+    m_lastUpdateCells = 0;
+    propagate();
+}
+
+std::int32_t DistanceField::cell(const int row, const int col) const {
+    return (row + 1) * m_stride + col + 1;
+}
+
+bool DistanceField::relaxFromNeighbours(const std::int32_t cell) {
+    bool improved = false;
+    for (const std::int32_t offset: m_offsets) {
+        const std::int32_t neighbour = cell + offset;
+        if (m_distance[neighbour] != infinity && m_distance[neighbour] + 1 < m_distance[cell]) {
+            m_distance[cell] = m_distance[neighbour] + 1;
+            m_owner[cell] = m_owner[neighbour];
+            improved = true;
+        }
+    }
+    return improved;
+}
+
+void DistanceField::propagate() {
+    // sursele au distante diferite, asa ca se iau sortate si se intercaleaza cu coada BFS
+    std::sort(m_seeds.begin(), m_seeds.end());
+    m_queue.clear();
+    std::size_t head = 0, nextSeed = 0;
+    while (head < m_queue.size() || nextSeed < m_seeds.size()) {
+        std::int32_t current;
+        if (head < m_queue.size() &&
+            (nextSeed == m_seeds.size() || m_distance[m_queue[head]] <= m_seeds[nextSeed].first)) {
+            current = m_queue[head++];
+        }
+        else {
+            const auto [distance, seed] = m_seeds[nextSeed++];
+            if (m_distance[seed] != distance) { // a primit intre timp o distanta mai buna
+                continue;
+            }
+            current = seed;
+        }
+
+        ++m_lastUpdateCells;
+        const std::int32_t next = m_distance[current] + 1;
+        for (const std::int32_t offset: m_offsets) {
+            const std::int32_t neighbour = current + offset;
+            if (m_open[neighbour] && next < m_distance[neighbour]) {
+                m_distance[neighbour] = next;
+                m_owner[neighbour] = m_owner[current];
+                m_queue.push_back(neighbour);
+            }
+        }
+    }
+    m_seeds.clear();
+}
+
+void DistanceField::removeSource(const int row, const int col) {
+    m_lastUpdateCells = 0;
+    if (row < 0 || col < 0 || row >= m_dim || col >= m_dim || m_owner[cell(row, col)] != cell(row, col)) {
+        return;
+    }
+    const std::int32_t source = cell(row, col);
+
+    // regiunea sursei este conexa: fiecare celula si-a primit sursa de la un vecin din aceeasi regiune
+    std::vector<std::int32_t> &region = m_queue;
+    region.assign(1, source);
+    m_owner[source] = -1;
+    m_distance[source] = infinity;
+    for (std::size_t i = 0; i < region.size(); i++) {
+        for (const std::int32_t offset: m_offsets) {
+            const std::int32_t neighbour = region[i] + offset;
+            if (m_owner[neighbour] == source) {
+                m_owner[neighbour] = -1;
+                m_distance[neighbour] = infinity;
+                region.push_back(neighbour);
+            }
+        }
+    }
+
+    // celulele din afara regiunii au in continuare distante corecte si devin sursele reumplerii
+    m_seeds.clear();
+    for (const std::int32_t current: region) {
+        if (relaxFromNeighbours(current)) {
+            m_seeds.emplace_back(m_distance[current], current);
+        }
+    }
+    m_lastUpdateCells = region.size();
+    propagate();
+}
+
+void DistanceField::openAround(const Maze &maze, const int row, const int col) {
+    m_lastUpdateCells = 0;
+    m_seeds.clear();
+    for (int r = std::max(row - 1, 0); r <= std::min(row + 1, m_dim - 1); r++) {
+        for (int c = std::max(col - 1, 0); c <= std::min(col + 1, m_dim - 1); c++) {
+            m_open[cell(r, c)] = !maze.isWall(r, c);
+        }
+    }
+    for (int r = std::max(row - 1, 0); r <= std::min(row + 1, m_dim - 1); r++) {
+        for (int c = std::max(col - 1, 0); c <= std::min(col + 1, m_dim - 1); c++) {
+            if (m_open[cell(r, c)] && relaxFromNeighbours(cell(r, c))) {
+                m_seeds.emplace_back(m_distance[cell(r, c)], cell(r, c));
+            }
+        }
+    }
+    propagate();
+}
+
+std::int32_t DistanceField::distance(const int row, const int col) const {
+    const std::int32_t d = m_distance[cell(row, col)];
+    return d == infinity ? unreachable : d;
+}
+
+std::pair<int, int> DistanceField::nearestSource(const int row, const int col) const {
+    const std::int32_t owner = m_owner[cell(row, col)];
+    return owner < 0 ? std::make_pair(-1, -1) : std::make_pair(owner / m_stride - 1, owner % m_stride - 1);
+}
+
+std::size_t DistanceField::lastUpdateCells() const {
+    return m_lastUpdateCells;
+}
@@ -0,0 +1,93 @@
+#include "EndlessGame.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <thread>
+#include <rlutil.h>
+
+EndlessGame::EndlessGame(const std::uint64_t worldSeed, const std::filesystem::path &directory, const std::size_t maxChunks)
+        : m_world(worldSeed, directory, maxChunks) {
+    m_world.prefetch(0, 0, 1);
+}
+
+bool EndlessGame::step(const int key_pressed) {
+    const auto [row, col] = m_player.getPosition();
+    int newRow = row, newCol = col;
+    switch (key_pressed) {
+        case 'w':
+            --newRow;
+            break;
+        case 'a':
+            --newCol;
+            break;
+        case 's':
+            ++newRow;
+            break;
+        case 'd':
+            ++newCol;
+            break;
+        case 'f':
+            m_world.createHole(row, col);
+            return true;
+        case 'q':
+            return false;
+        default:
+            return true;
+    }
+
+    if (m_world.isPositionAvailable(newRow, newCol)) {
+        m_player = {newRow, newCol};
+        m_farthest = std::max(m_farthest, std::abs(newRow) + std::abs(newCol));
+        m_world.prefetch(newRow, newCol, 1); // chunk-urile vecine sunt gata inainte ca jucatorul sa ajunga la ele
+    }
+    return true;
+}
+
+void EndlessGame::renderFrame(std::string &frame) {
+    const auto [row, col] = m_player.getPosition();
+    frame.clear();
+    frame += rlutil::ANSI_CURSOR_HOME;
+
+    for (int r = row - viewRows / 2; r <= row + viewRows / 2; r++) {
+        for (int c = col - viewCols / 2; c <= col + viewCols / 2; c++) {
+            frame += r == row && c == col ? 'T' : m_world.isWall(r, c) ? '#' : ' ';
+        }
+        frame += '\n';
+    }
+
+    const ChunkedMaze::Stats stats = m_world.stats();
+    frame += "Position (" + std::to_string(row) + ", " + std::to_string(col) + "), farthest " +
+             std::to_string(m_farthest) + " | chunks in memory " + std::to_string(m_world.residentChunks()) +
+             ", generated " + std::to_string(stats.generated) + ", saved " + std::to_string(stats.saved) + "    \n";
+}
+
+void EndlessGame::run() {
+    rlutil::cls();
+    std::string frame;
+    renderFrame(frame);
+    std::cout << frame << std::flush;
+
+    while (true) {
+        const int key_pressed = rlutil::nb_getch();
+        if (key_pressed <= 0) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(15));
+            continue;
+        }
+        if (!step(key_pressed)) {
+            break;
+        }
+        renderFrame(frame);
+        std::cout << frame << std::flush;
+    }
+    m_world.flush();
+}
+
+const Player &EndlessGame::getPlayer() const {
+    return m_player;
+}
+
+const ChunkedMaze &EndlessGame::getWorld() const {
+    return m_world;
+}
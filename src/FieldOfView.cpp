@@ -0,0 +1,144 @@
+#include "FieldOfView.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+
+void FieldOfView::reset(const Maze &maze, const int radius, const int row, const int col) {
+    m_dim = maze.getSize();
+    m_radius = std::max(radius, 1);
+    m_radiusSquared = m_radius * (m_radius + 1);
+    m_wall.resize((std::size_t) m_dim * m_dim);
+    for (int r = 0; r < m_dim; r++) {
+        for (int c = 0; c < m_dim; c++) {
+            m_wall[(std::size_t) r * m_dim + c] = maze.isWall(r, c);
+        }
+    }
+    m_stamp.assign(m_wall.size(), 0);
+    m_generation = 0;
+    moveTo(row, col);
+}
+
+void FieldOfView::moveTo(const int row, const int col) {
+    m_row = row;
+    m_col = col;
+    compute();
+}
+
+void FieldOfView::openAround(const Maze &maze, const int row, const int col) {
+    bool changedInView = false;
+    for (int r = row - 1; r <= row + 1; r++) {
+        for (int c = col - 1; c <= col + 1; c++) {
+            if (r < 0 || c < 0 || r >= m_dim || c >= m_dim) {
+                continue;
+            }
+            std::uint8_t &wall = m_wall[(std::size_t) r * m_dim + c];
+            if (wall && !maze.isWall(r, c)) {
+                wall = 0;
+                // un zid mai departe decat raza nu acopera nimic din ce se poate vedea
+                changedInView |= std::max(std::abs(r - m_row), std::abs(c - m_col)) <= m_radius;
+            }
+        }
+    }
+    if (changedInView) {
+        compute();
+    }
+}
+
+void FieldOfView::compute() {
+    if (++m_generation == 0) { // dupa 2^32 calcule marcajele vechi ar parea din nou valide
+        std::fill(m_stamp.begin(), m_stamp.end(), 0);
+        m_generation = 1;
+    }
+    m_visible.clear();
+    markVisible(m_row, m_col);
+
+    // (xx, xy, yx, yy) duce coordonatele octantei (dx, dy) in labirint: coloana = col + dx * xx + dy * xy,
+    // randul = row + dx * yx + dy * yy
+    constexpr int octants[8][4] = {{1,  0,  0,  1},
+                                   {0,  1,  1,  0},
+                                   {0,  -1, 1,  0},
+                                   {-1, 0,  0,  1},
+                                   {-1, 0,  0,  -1},
+                                   {0,  -1, -1, 0},
+                                   {0,  1,  -1, 0},
+                                   {1,  0,  0,  -1}};
+    for (const auto &octant: octants) { // cppcheck-suppress constVariable
+        castLight(1, 1.0, 0.0, octant[0], octant[1], octant[2], octant[3]);
+    }
+}
+
+void FieldOfView::castLight(const int distance, double start, const double end, const int xx, const int xy,
+                            const int yx, const int yy) {
+    if (start < end) {
+        return;
+    }
+
+    double newStart = 0.0;
+    for (int j = distance; j <= m_radius; j++) {
+        const int dy = -j;
+        bool blocked = false;
+        // prima celula din con are (dx + 0.5) / (dy - 0.5) <= start; floor mai ia cel mult o celula in plus, pe
+        // care o sare verificarea de mai jos, dar nu pierde niciuna din cauza rotunjirii
+        for (int dx = std::max(-j, (int) std::floor(-start * (j + 0.5) - 0.5)); dx <= 0; dx++) {
+            const double leftSlope = (dx - 0.5) / (dy + 0.5);
+            const double rightSlope = (dx + 0.5) / (dy - 0.5);
+            if (start < rightSlope) {
+                continue;
+            }
+            if (end > leftSlope) {
+                break;
+            }
+
+            const int col = m_col + dx * xx + dy * xy;
+            const int row = m_row + dx * yx + dy * yy;
+            const bool inside = row >= 0 && col >= 0 && row < m_dim && col < m_dim;
+            const bool opaque = !inside || m_wall[(std::size_t) row * m_dim + col];
+            if (inside && dx * dx + dy * dy <= m_radiusSquared) {
+                markVisible(row, col);
+            }
+
+            if (blocked) { // in umbra unui zid de pe acest rand
+                if (opaque) {
+                    newStart = rightSlope;
+                    continue;
+                }
+                blocked = false;
+                start = newStart;
+            }
+            else if (opaque && j < m_radius) { // zidul imparte conul: partea din stanga lui se cerceteaza separat
+                blocked = true;
+                castLight(j + 1, start, leftSlope, xx, xy, yx, yy);
+                newStart = rightSlope;
+            }
+        }
+        if (blocked) { // randul s-a terminat cu zid, deci conul ramas este acoperit in intregime
+            break;
+        }
+    }
+}
+
+void FieldOfView::markVisible(const int row, const int col) {
+    std::uint32_t &stamp = m_stamp[(std::size_t) row * m_dim + col];
+    if (stamp != m_generation) { // axele si diagonalele apartin la doua octante
+        stamp = m_generation;
+        m_visible.emplace_back(row, col);
+    }
+}
+
+bool FieldOfView::isVisible(const int row, const int col) const {
+    return row >= 0 && col >= 0 && row < m_dim && col < m_dim &&
+           m_stamp[(std::size_t) row * m_dim + col] == m_generation;
+}
+
+const std::vector<std::pair<int, int>> &FieldOfView::visibleCells() const {
+    return m_visible;
+}
+
+std::pair<int, int> FieldOfView::origin() const {
+    return {m_row, m_col};
+}
+
+int FieldOfView::radius() const {
+    return m_radius;
+}
@@ -0,0 +1,651 @@
+#include "Game.h"
+
+#include <algorithm>
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+
+#include "ApplePlacement.h"
+#include "DifficultyTable.h"
+#include "Zobrist.h"
+
+namespace {
+    // aceleasi secvente ANSI pe care rlutil le scrie direct in consola pe Linux/macOS
+    void appendLocate(std::string &frame, const int x, const int y) {
+        frame += "\033[" + std::to_string(y) + ';' + std::to_string(x) + 'H';
+    }
+
+    void appendColored(std::string &frame, const int color, const char *text) {
+        frame += rlutil::getANSIColor(color);
+        frame += text;
+        frame += rlutil::ANSI_WHITE;
+    }
+
+    // lungimea traseului de referinta pentru labirinturile generate de Game::start, dupa dimensiune si hash-ul
+    // Zobrist al peretilor, merelor si bombei: acelasi seed al generatorului global da acelasi labirint, care nu se
+    // mai analizeaza
+    struct ParLengthCache {
+        static constexpr std::size_t capacity = 4096; // plin, se goleste; labirinturile aleatoare rareori se repeta
+
+        std::mutex mutex;
+        std::map<std::pair<int, std::uint64_t>, int> lengths;
+    };
+
+    ParLengthCache &parLengthCache() {
+        static ParLengthCache cache;
+        return cache;
+    }
+}
+
+std::vector<Object> Game::placeApples(const std::vector<std::pair<int, int>> &freeCells) {
+    std::vector<Object> apples;
+    placeApplesOnFreeCells((int) freeCells.size(),
+                           [](const int from, const int to) { return effolkronium::random_static::get(from, to); },
+                           [&apples, &freeCells](const int index) {
+                               apples.push_back(Object{freeCells[index].first, freeCells[index].second});
+                           });
+    return apples;
+}
+
+std::vector<Object> Game::placeApples(const std::vector<std::pair<int, int>> &freeCells, SplitMix64 &rng) {
+    std::vector<Object> apples;
+    placeApplesOnFreeCells((int) freeCells.size(), [&rng](const int from, const int to) { return uniformInt(rng, from, to); },
+                           [&apples, &freeCells](const int index) {
+                               apples.push_back(Object{freeCells[index].first, freeCells[index].second});
+                           });
+    return apples;
+}
+
+void Game::generate() {
+    // bomba se trage prima, ca atunci cand o punea constructorul, ca inregistrarile vechi sa se reia la fel
+    bomb = Object{0, effolkronium::random_static::get(2, m_mazeSize - 1), rlutil::CYAN};
+    m_maze.generate();
+    objects = placeApples(m_maze.getFreeCells());
+    m_levelRng.reset();
+}
+
+std::chrono::seconds Game::legacyTimeLimit() const {
+    return DifficultyTable::legacyTimeLimit(objects.size());
+}
+
+std::chrono::seconds Game::generatedTimeLimit() const {
+    const DifficultyTable &table = DifficultyTable::shared();
+    if (table.empty()) {
+        return legacyTimeLimit();
+    }
+
+    std::uint64_t levelHash = m_maze.getHash() ^ Zobrist::bomb(bomb.getPosition().second);
+    for (const Object &obj: objects) {
+        const auto [row, col] = obj.getPosition();
+        levelHash ^= Zobrist::cell(Zobrist::Feature::Apple, m_mazeSize, row, col);
+    }
+    const std::pair<int, std::uint64_t> key{m_mazeSize, levelHash};
+
+    Level level;
+    level.dim = m_mazeSize;
+    ParLengthCache &cache = parLengthCache();
+    {
+        const std::lock_guard<std::mutex> lock(cache.mutex);
+        const auto it = cache.lengths.find(key);
+        if (it != cache.lengths.end()) {
+            level.parLength = it->second;
+            return table.timeLimit(level);
+        }
+    }
+
+    // tabela da timpul dupa traseul de referinta, deci labirintul generat se analizeaza ca un nivel
+    level.wall.resize((std::size_t) m_mazeSize * m_mazeSize);
+    for (int row = 0; row < m_mazeSize; row++) {
+        for (int col = 0; col < m_mazeSize; col++) {
+            level.wall[(std::size_t) row * m_mazeSize + col] = m_maze.isWall(row, col);
+        }
+    }
+    for (const Object &obj: objects) {
+        level.apples.push_back(obj.getPosition());
+    }
+    level.bombCol = bomb.getPosition().second;
+    level.analyze();
+
+    {
+        const std::lock_guard<std::mutex> lock(cache.mutex);
+        if (cache.lengths.size() >= ParLengthCache::capacity) {
+            cache.lengths.clear();
+        }
+        cache.lengths.emplace(key, level.parLength);
+    }
+    return table.timeLimit(level);
+}
+
+void Game::start(const Clock::time_point now) {
+    generate();
+    begin(now, generatedTimeLimit());
+}
+
+void Game::start(const Clock::time_point now, const Level &level, const std::chrono::seconds timeLimit) {
+    if (level.dim != m_mazeSize) {
+        throw std::invalid_argument("level size does not match the game's maze size");
+    }
+
+    m_maze.assign(level.wall);
+    objects.clear();
+    objects.reserve(level.apples.size());
+    for (const auto &[row, col]: level.apples) {
+        objects.emplace_back(row, col);
+    }
+    bomb = Object{0, level.bombCol, rlutil::CYAN};
+    m_levelRng.emplace(level.seed ^ 0xB0B5B0B5B0B5B0B5ULL); // alt flux decat cel din care s-a generat nivelul
+
+    begin(now, timeLimit);
+}
+
+void Game::begin(const Clock::time_point now, const std::chrono::seconds timeLimit) {
+    gameStarted = now;
+    m_now = now;
+    m_timers = TimerWheel{gameStarted};
+    m_timeLimit = timeLimit;
+
+    m_hash = Zobrist::player(0, m_mazeSize, m_player.getPosition().first, m_player.getPosition().second);
+    for (const Object &obj: objects) {
+        m_hash ^= Zobrist::cell(Zobrist::Feature::Apple, m_mazeSize, obj.getPosition().first, obj.getPosition().second);
+    }
+    if (bomb.getPosition().second != m_mazeSize - 1) {
+        m_hash ^= Zobrist::bomb(bomb.getPosition().second);
+    }
+
+    std::vector<std::pair<int, int>> apples;
+    apples.reserve(objects.size());
+    for (const Object &obj: objects) {
+        apples.push_back(obj.getPosition());
+    }
+    m_appleField.reset(m_maze, apples);
+    if (m_fogRadius > 0) {
+        m_view.reset(m_maze, m_fogRadius, m_player.getPosition().first, m_player.getPosition().second);
+    }
+
+    m_timers.schedule(m_timeLimit, [this]() { // a trecut timpul alocat jocului -> il opresc
+        m_isRunning = false;
+        m_timeExpired = true;
+    });
+    scheduleHudRefresh();
+}
+
+void Game::advanceTo(const Clock::time_point now) {
+    m_now = now;
+    m_timers.advance(now);
+}
+
+void Game::step(const Clock::time_point now, const int key_pressed) {
+    advanceTo(now);
+    if (!m_isRunning) {
+        return;
+    }
+
+    handleEvent(key_pressed, m_toggleRender);
+    if (m_toggleRender) {
+        render();
+        m_toggleRender = false;
+    }
+}
+
+void Game::advance(const Clock::time_point now) {
+    advanceTo(now);
+    if (m_isRunning && m_toggleRender) {
+        render();
+        m_toggleRender = false;
+    }
+}
+
+Game::Clock::time_point Game::nextDeadline() const {
+    return m_timers.nextExpiry();
+}
+
+void Game::setFrameSink(FrameSink sink) {
+    m_frameSink = std::move(sink);
+}
+
+void Game::setRenderEnabled(const bool enabled) {
+    m_renderEnabled = enabled;
+}
+
+void Game::setFogOfWar(const int radius) {
+    m_fogRadius = std::max(radius, 0);
+}
+
+bool Game::isShown(const int row, const int col) const {
+    return m_fogRadius == 0 || m_view.isVisible(row, col);
+}
+
+bool Game::isRunning() const {
+    return m_isRunning;
+}
+
+void Game::run(Recording &recording) {
+    start(Clock::now());
+    recording.setTimeLimit(m_timeLimit); // tabela de dificultate se poate schimba pana la replay
+    play(recording);
+}
+
+void Game::runLevel(const Level &level, const std::chrono::seconds timeLimit) {
+    start(Clock::now(), level, timeLimit);
+    Recording unused; // nivelurile pregatite nu se inregistreaza; replay-ul porneste de la seed-ul lui Game::start
+    play(unused);
+}
+
+void Game::play(Recording &recording) {
+    // intre evenimente bucla doarme pana la urmatorul timer, dar nu mai mult de inputPoll ca tastele sa fie citite la timp
+    constexpr auto inputPoll = std::chrono::milliseconds(15);
+
+    while (m_isRunning) {
+        // momentul e trunchiat la ms, exact cum e salvat in inregistrare, ca replay-ul sa vada aceleasi timere expirate
+        const auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(Clock::now() - gameStarted);
+        advanceTo(gameStarted + elapsed);
+
+        if (!m_isRunning) {
+            break;
+        }
+
+        const int key_pressed = rlutil::nb_getch();
+        if (key_pressed > 0) {
+            recording.addEvent((std::uint64_t) elapsed.count(), (char) key_pressed);
+            handleEvent(key_pressed, m_toggleRender);
+        }
+
+        if (m_toggleRender) {
+            render();
+            m_toggleRender = false;
+        }
+        else {
+            std::this_thread::sleep_until(std::min(m_timers.nextExpiry(), Clock::now() + inputPoll));
+        }
+    }
+
+    recording.setEndTime((std::uint64_t) std::chrono::duration_cast<std::chrono::milliseconds>(m_now - gameStarted).count());
+    showResult();
+}
+
+void Game::replay(const Recording &recording, const bool realTime) {
+    m_renderEnabled = realTime;
+    generate();
+    // inregistrarile dinainte de tabela de dificultate nu au timpul salvat si foloseau regula veche
+    const std::chrono::seconds timeLimit = recording.getTimeLimit();
+    begin(Clock::now(), timeLimit > std::chrono::seconds::zero() ? timeLimit : legacyTimeLimit());
+
+    for (const Recording::Event &event: recording.getEvents()) {
+        const Clock::time_point eventTime = gameStarted + std::chrono::milliseconds(event.timeMs);
+
+        if (realTime) { // intre taste las timerele (HUD, bomba) sa ruleze ca in jocul original
+            while (m_timers.nextExpiry() < eventTime && m_isRunning) {
+                std::this_thread::sleep_until(m_timers.nextExpiry());
+                advanceTo(m_timers.nextExpiry());
+                if (m_toggleRender) {
+                    render();
+                    m_toggleRender = false;
+                }
+            }
+            std::this_thread::sleep_until(eventTime);
+        }
+
+        step(eventTime, event.key);
+        if (!m_isRunning) {
+            break;
+        }
+    }
+
+    if (m_isRunning) { // sesiunea s-a terminat fara tasta (de exemplu a expirat timpul)
+        advanceTo(gameStarted + std::chrono::milliseconds(recording.getEndTime()));
+    }
+
+    showResult();
+}
+
+bool Game::isWon() const {
+    return objects.empty() && !m_timeExpired;
+}
+
+std::string Game::resultMessage() const {
+    if(isWon()) {
+        return "Newton found his apples. Now he will study the laws of gravity.";
+    }
+    return "Newton couldn't find its apples.";
+}
+
+std::string Game::nearestAppleText() const {
+    const auto [row, col] = m_player.getPosition();
+    const std::int32_t distance = m_appleField.distance(row, col);
+    return distance == DistanceField::unreachable ? ", none reachable"
+                                                  : ", nearest " + std::to_string(distance) + " steps away";
+}
+
+const DistanceField &Game::appleDistances() const {
+    return m_appleField;
+}
+
+const Maze &Game::getMaze() const {
+    return m_maze;
+}
+
+std::pair<int, int> Game::playerPosition() const {
+    return m_player.getPosition();
+}
+
+bool Game::playerHasBomb() const {
+    return m_player.getHasBomb();
+}
+
+const std::vector<Object> &Game::getApples() const {
+    return objects;
+}
+
+bool Game::hasApple(const int row, const int col) const {
+    return std::any_of(objects.begin(), objects.end(), [row, col](const Object &obj) {
+        return obj.getPosition() == std::make_pair(row, col);
+    });
+}
+
+int Game::applesLeft() const {
+    return (int) objects.size();
+}
+
+int Game::bombColumn() const { // bomba de pe ultima coloana este cea deja luata (vezi handleEvent)
+    return bomb.getPosition().second != m_mazeSize - 1 ? bomb.getPosition().second : -1;
+}
+
+void Game::showResult() const {
+    if (m_renderEnabled) {
+        rlutil::cls();
+    }
+
+    std::cout << resultMessage() << std::endl;
+
+    if (!m_renderEnabled) { // la replay rapid afisez starea finala, ca doua rulari sa poata fi comparate
+        const std::pair<int, int> position = m_player.getPosition();
+        std::cout << "Apples left: " << objects.size() << ", player at (" << position.first << ", "
+                  << position.second << "), bomb in hand: " << m_player.getHasBomb() << std::endl;
+    }
+}
+
+void Game::scheduleHudRefresh() { // timpul ramas se afiseaza la secunda, deci HUD-ul se actualizeaza o data pe secunda
+    m_timers.schedule(std::chrono::seconds(1), [this]() {
+        renderHud();
+        scheduleHudRefresh();
+    });
+}
+
+std::string Game::hudText() const {
+    const auto elapsed = std::chrono::duration_cast<std::chrono::seconds>(m_now - gameStarted);
+    const long long secondsLeft = std::max(0LL, (long long) (m_timeLimit - elapsed).count());
+
+    return "Time remaining: " + std::to_string(secondsLeft / 60) + ':' + (secondsLeft % 60 < 10 ? "0" : "") +
+           std::to_string(secondsLeft % 60) + " minutes left.";
+}
+
+void Game::renderHud() const {
+    if (!m_renderEnabled) {
+        return;
+    }
+
+    if (m_frameSink) {
+        std::string hud;
+        appendLocate(hud, 1, m_mazeSize + 2);
+        hud += hudText();
+        m_frameSink(hud);
+        return;
+    }
+
+    gotoxy(1, m_mazeSize + 2);
+    std::cout << hudText();
+    std::cout.flush();
+}
+
+void Game::renderFrame(std::string &frame) const {
+    frame.clear();
+    frame += rlutil::ANSI_CLS;
+    frame += rlutil::ANSI_CURSOR_HOME;
+
+    if (m_fogRadius > 0) { // ecranul e deja gol, deci se scriu doar celulele vazute
+        for (const auto &[row, col]: m_view.visibleCells()) {
+            appendLocate(frame, col + 1, row + 1);
+            frame += m_maze.isWall(row, col) ? '#' : ' ';
+        }
+    }
+    else {
+        std::ostringstream maze;
+        maze << m_maze;
+        frame += maze.str();
+    }
+
+    appendLocate(frame, 1, m_mazeSize + 2);
+    frame += hudText();
+
+    appendLocate(frame, 1, m_mazeSize + 3);
+    if (objects.empty()) {
+        frame += "You've collected all the apples! The exit is marked with ";
+        appendColored(frame, rlutil::LIGHTGREEN, "<<");
+    }
+    else {
+        frame += "Apples left to collect: " + std::to_string(objects.size()) + nearestAppleText();
+    }
+
+    // iesirea din labirint, apoi bomba, merele si jucatorul, ca in render()
+    appendLocate(frame, 1, 1);
+    appendColored(frame, objects.empty() ? rlutil::LIGHTGREEN : rlutil::LIGHTRED, objects.empty() ? "<<" : ">>");
+
+    if (isShown(bomb.getPosition().first, bomb.getPosition().second)) {
+        appendLocate(frame, bomb.getPosition().second + 1, bomb.getPosition().first + 1);
+        appendColored(frame, bomb.getColor(), "O");
+    }
+
+    for (const Object &obj: objects) {
+        if (isShown(obj.getPosition().first, obj.getPosition().second)) {
+            appendLocate(frame, obj.getPosition().second + 1, obj.getPosition().first + 1);
+            appendColored(frame, obj.getColor(), "O");
+        }
+    }
+
+    appendLocate(frame, m_player.getPosition().second + 1, m_player.getPosition().first + 1);
+    appendColored(frame, rlutil::BROWN, "T");
+}
+
+void Game::movePlayer(const int row, const int col) {
+    const auto [crtRow, crtCol] = m_player.getPosition();
+    m_hash ^= Zobrist::player(0, m_mazeSize, crtRow, crtCol) ^ Zobrist::player(0, m_mazeSize, row, col);
+    m_player = std::make_pair(row, col);
+    if (m_fogRadius > 0) {
+        m_view.moveTo(row, col);
+    }
+}
+
+std::uint64_t Game::stateHash() const {
+    return m_maze.getHash() ^ m_hash;
+}
+
+void Game::syncState(SyncState &state) const {
+    state.dim = m_mazeSize;
+    state.wall.resize((std::size_t) m_mazeSize * m_mazeSize);
+    state.apple.assign(state.wall.size(), 0);
+    for (int row = 0; row < m_mazeSize; row++) {
+        for (int col = 0; col < m_mazeSize; col++) {
+            state.wall[(std::size_t) row * m_mazeSize + col] = m_maze.isWall(row, col);
+        }
+    }
+    for (const Object &obj: objects) {
+        state.apple[(std::size_t) obj.getPosition().first * m_mazeSize + obj.getPosition().second] = 1;
+    }
+
+    state.bombCol = bombColumn();
+
+    const auto [row, col] = m_player.getPosition();
+    state.players.assign(1, SyncState::PlayerState{row, col, m_player.getHasBomb(), 0});
+    state.hash = stateHash();
+}
+
+void Game::render() {
+    if (!m_renderEnabled) {
+        return;
+    }
+
+    if (m_frameSink) {
+        std::string frame;
+        renderFrame(frame);
+        m_frameSink(frame);
+        return;
+    }
+
+    rlutil::cls();
+
+    if (m_fogRadius > 0) {
+        for (const auto &[row, col]: m_view.visibleCells()) {
+            gotoxy(col + 1, row + 1);
+            std::cout << (m_maze.isWall(row, col) ? '#' : ' ');
+        }
+    }
+    else {
+        std::cout << m_maze;
+    }
+
+    renderHud();
+
+    const int applesLeft = (int) objects.size();
+
+    if(applesLeft == 0) {
+        std::cout<<std::endl<<"You've collected all the apples! The exit is marked with ";
+        rlutil::setColor(rlutil::LIGHTGREEN);
+        std::cout<<"<<";
+        rlutil::setColor(rlutil::WHITE);
+    }
+    else {
+        std::cout<<std::endl<<"Apples left to collect: " << applesLeft << nearestAppleText();
+    }
+
+    // aici marchez iesirea din labirint
+    const int objectsRemained = (int) objects.size();
+    if (objectsRemained != 0) {
+        gotoxy(1, 1);
+        rlutil::setColor(rlutil::LIGHTRED);
+        std::cout << ">>";
+        rlutil::setColor(rlutil::WHITE);
+    }
+    else {
+        gotoxy(1, 1);
+        rlutil::setColor(rlutil::LIGHTGREEN);
+        std::cout << "<<";
+        rlutil::setColor(rlutil::WHITE);
+    }
+
+    if (isShown(bomb.getPosition().first, bomb.getPosition().second)) {
+        std::cout << bomb;
+    }
+    for (Object &obj: objects) { // afisez merele pe ecran (cu ceata, doar pe cele vazute)
+        if (isShown(obj.getPosition().first, obj.getPosition().second)) {
+            std::cout << obj;
+        }
+    }
+
+    std::cout << m_player;
+    std::cout.flush();
+}
+
+void Game::handleEvent(const int key_pressed, bool &renderFlag) {
+    std::pair<int, int> playerPosition = m_player.getPosition();
+    const int crtRow = playerPosition.first;
+    const int crtCol = playerPosition.second;
+
+    switch (std::tolower(key_pressed)) {
+        case rlutil::KEY_SPACE: {
+            std::erase_if(objects, [&](const Object &item) {
+                const std::pair<int, int> objPosition = item.getPosition();
+                if (playerPosition != objPosition) {
+                    return false;
+                }
+                m_hash ^= Zobrist::cell(Zobrist::Feature::Apple, m_mazeSize, crtRow, crtCol);
+                return true;
+            }); // daca jucatorul se afla pe un obiect inseamna ca a luat obiectul => il sterg din vector
+            m_appleField.removeSource(crtRow, crtCol); // nu face nimic daca aici nu era un mar
+
+            std::pair<int, int> bombPosition = bomb.getPosition();
+
+            if (playerPosition == bombPosition && bombPosition.second != m_mazeSize - 1) { // daca jucatorul a luat bomba
+                // si bomba a fost generata
+                m_hash ^= Zobrist::bomb(bombPosition.second);
+                if (!m_player.getHasBomb()) {
+                    m_hash ^= Zobrist::hasBomb(0);
+                }
+                m_player.setHasBomb(true);
+                const Object offBomb{0, m_mazeSize - 1, rlutil::LIGHTGREEN};
+                bomb = offBomb;
+
+                m_timers.schedule(std::chrono::seconds(5), [this]() { // dupa 5 secunde generez o bomba noua
+                    const int column = m_levelRng ? uniformInt(*m_levelRng, 2, m_mazeSize - 2)
+                                                  : effolkronium::random_static::get(2, m_mazeSize - 2);
+                    const Object newBomb = Object{0, column, rlutil::CYAN};
+                    bomb = newBomb;
+                    m_hash ^= Zobrist::bomb(bomb.getPosition().second);
+                    m_toggleRender = true;
+                });
+            }
+
+            renderFlag = true;
+
+            break;
+        }
+
+        case 'f': {
+            if (m_player.getHasBomb()) { // jucatorul vrea sa foloseasca bomba
+                m_maze.createHole(crtRow, crtCol);
+                m_appleField.openAround(m_maze, crtRow, crtCol);
+                if (m_fogRadius > 0) {
+                    m_view.openAround(m_maze, crtRow, crtCol);
+                }
+                m_player.setHasBomb(false);
+                m_hash ^= Zobrist::hasBomb(0);
+            }
+
+            renderFlag = true;
+            break;
+        }
+        case 'w': {
+            if (m_maze.isPositionAvailable(crtRow - 1, crtCol)) {
+                movePlayer(crtRow - 1, crtCol);
+            }
+
+            renderFlag = true;
+            break;
+        }
+        case 'a': {
+            if (m_maze.isPositionAvailable(crtRow, crtCol - 1)) {
+                movePlayer(crtRow, crtCol - 1);
+            }
+
+            renderFlag = true;
+            break;
+        }
+        case 's': {
+            if (m_maze.isPositionAvailable(crtRow + 1, crtCol)) {
+                movePlayer(crtRow + 1, crtCol);
+            }
+
+            renderFlag = true;
+            break;
+        }
+        case 'd': {
+            if (m_maze.isPositionAvailable(crtRow, crtCol + 1)) {
+                movePlayer(crtRow, crtCol + 1);
+            }
+
+            renderFlag = true;
+            break;
+        }
+        case 'q': { // exit
+            m_isRunning = false;
+            break;
+        }
+        default:
+            break;
+    }
+
+    if (objects.empty() && m_player.getPosition() == std::make_pair(0, 0)) { // a ajuns la iesire cu toate merele
+        m_isRunning = false;
+    }
+}
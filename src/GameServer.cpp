@@ -0,0 +1,532 @@
+#include "GameServer.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include "Varint.h"
+
+namespace {
+    constexpr std::uint64_t listenerId = 0;
+    constexpr std::uint64_t wakeId = ~0ULL;
+
+    std::runtime_error systemError(const std::string &what) {
+        return std::runtime_error(what + ": " + std::strerror(errno));
+    }
+
+    sockaddr_un unixAddress(const std::string &path) {
+        sockaddr_un address{};
+        address.sun_family = AF_UNIX;
+        if (path.size() >= sizeof(address.sun_path)) {
+            throw std::runtime_error("unix socket path too long: " + path);
+        }
+        std::memcpy(address.sun_path, path.c_str(), path.size() + 1);
+        return address;
+    }
+
+    sockaddr_in loopbackAddress(const int port) {
+        sockaddr_in address{};
+        address.sin_family = AF_INET;
+        address.sin_port = htons((std::uint16_t) port);
+        address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        return address;
+    }
+}
+
+Endpoint Endpoint::parse(const std::string &text) {
+    Endpoint endpoint;
+    if (text.starts_with("unix:") && text.size() > 5) {
+        endpoint.isUnix = true;
+        endpoint.path = text.substr(5);
+        return endpoint;
+    }
+    if (text.starts_with("tcp:")) {
+        try {
+            endpoint.port = std::stoi(text.substr(4));
+        }
+        catch (const std::exception &) {
+            endpoint.port = 0;
+        }
+        if (endpoint.port > 0 && endpoint.port < 65536) {
+            return endpoint;
+        }
+    }
+    throw std::invalid_argument("endpoint must be unix:<path> or tcp:<port>, got '" + text + "'");
+}
+
+int connectTo(const Endpoint &endpoint) {
+    const int fd = socket(endpoint.isUnix ? AF_UNIX : AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (fd < 0) {
+        throw systemError("socket");
+    }
+
+    int result = 0;
+    if (endpoint.isUnix) {
+        const sockaddr_un address = unixAddress(endpoint.path);
+        result = ::connect(fd, reinterpret_cast<const sockaddr *>(&address), sizeof(address));
+    }
+    else {
+        const sockaddr_in address = loopbackAddress(endpoint.port);
+        result = ::connect(fd, reinterpret_cast<const sockaddr *>(&address), sizeof(address));
+        const int noDelay = 1;
+        setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &noDelay, sizeof(noDelay));
+    }
+
+    if (result < 0) {
+        const std::runtime_error error = systemError("connect");
+        ::close(fd);
+        throw error;
+    }
+    return fd;
+}
+
+GameServer::GameServer(const Endpoint &endpoint, const std::size_t maxPendingBytes, const std::size_t maxSpectatorBytes)
+        : m_endpoint(endpoint), m_maxPendingBytes(maxPendingBytes), m_maxSpectatorBytes(maxSpectatorBytes) {
+    m_listenFd = socket(endpoint.isUnix ? AF_UNIX : AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (m_listenFd < 0) {
+        throw systemError("socket");
+    }
+
+    int result = 0;
+    if (endpoint.isUnix) {
+        unlink(endpoint.path.c_str()); // socket ramas de la o rulare anterioara
+        const sockaddr_un address = unixAddress(endpoint.path);
+        result = bind(m_listenFd, reinterpret_cast<const sockaddr *>(&address), sizeof(address));
+    }
+    else {
+        const int reuse = 1;
+        setsockopt(m_listenFd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+        const sockaddr_in address = loopbackAddress(endpoint.port);
+        result = bind(m_listenFd, reinterpret_cast<const sockaddr *>(&address), sizeof(address));
+    }
+
+    if (result < 0 || listen(m_listenFd, SOMAXCONN) < 0) {
+        const std::runtime_error error = systemError("cannot listen on " + (endpoint.isUnix ? endpoint.path : std::to_string(endpoint.port)));
+        ::close(m_listenFd);
+        throw error;
+    }
+
+    m_epollFd = epoll_create1(EPOLL_CLOEXEC);
+    m_wakeFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (m_epollFd < 0 || m_wakeFd < 0) {
+        throw systemError("epoll/eventfd");
+    }
+
+    epoll_event listener{};
+    listener.events = EPOLLIN;
+    listener.data.u64 = listenerId;
+    epoll_event wake{};
+    wake.events = EPOLLIN;
+    wake.data.u64 = wakeId;
+    if (epoll_ctl(m_epollFd, EPOLL_CTL_ADD, m_listenFd, &listener) < 0 ||
+        epoll_ctl(m_epollFd, EPOLL_CTL_ADD, m_wakeFd, &wake) < 0) {
+        throw systemError("epoll_ctl");
+    }
+}
+
+GameServer::~GameServer() {
+    for (auto &[id, session]: m_sessions) {
+        ::close(session->fd);
+    }
+    ::close(m_listenFd);
+    ::close(m_epollFd);
+    ::close(m_wakeFd);
+    if (m_endpoint.isUnix) {
+        unlink(m_endpoint.path.c_str());
+    }
+}
+
+void GameServer::run() {
+    std::vector<epoll_event> events(256);
+    m_timers = TimerWheel{Clock::now()};
+
+    while (!m_stopping.load()) {
+        const Clock::time_point now = Clock::now();
+        m_timers.advance(now);
+
+        // rotunjit in sus, ca sa nu ma trezesc cu putin inainte de timer si sa fac o iteratie degeaba
+        const auto untilTimer = std::chrono::ceil<std::chrono::milliseconds>(m_timers.nextExpiry() - now);
+        const int timeout = (int) std::clamp<long long>(untilTimer.count(), 0, 1000);
+
+        const int ready = epoll_wait(m_epollFd, events.data(), (int) events.size(), timeout);
+        if (ready < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            throw systemError("epoll_wait");
+        }
+
+        for (int i = 0; i < ready; i++) {
+            const epoll_event &event = events[i];
+            if (event.data.u64 == listenerId) {
+                accept();
+                continue;
+            }
+            if (event.data.u64 == wakeId) {
+                std::uint64_t value = 0;
+                [[maybe_unused]] const ssize_t ignored = read(m_wakeFd, &value, sizeof(value));
+                continue;
+            }
+
+            const auto it = m_sessions.find(event.data.u64);
+            if (it == m_sessions.end() || it->second->closed) {
+                continue;
+            }
+            Session &session = *it->second;
+
+            if (event.events & EPOLLERR) {
+                close(session);
+                continue;
+            }
+            if (event.events & (EPOLLIN | EPOLLHUP)) {
+                onReadable(session);
+            }
+            if (!session.closed && (event.events & EPOLLOUT)) {
+                onWritable(session);
+            }
+            if (!session.closed && (event.events & EPOLLHUP)) { // conexiunea e inchisa in ambele sensuri
+                close(session);
+            }
+        }
+
+        for (const std::uint64_t id: m_closed) {
+            m_sessions.erase(id);
+        }
+        m_closed.clear();
+    }
+}
+
+void GameServer::stop() {
+    m_stopping.store(true);
+    const std::uint64_t one = 1;
+    [[maybe_unused]] const ssize_t ignored = write(m_wakeFd, &one, sizeof(one));
+}
+
+std::size_t GameServer::sessionCount() const {
+    return m_sessions.size() - m_closed.size();
+}
+
+void GameServer::accept() {
+    while (true) {
+        const int fd = accept4(m_listenFd, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (fd < 0) { // EAGAIN: nu mai sunt conexiuni; EMFILE si altele: raman in coada pana se elibereaza resurse
+            return;
+        }
+        if (!m_endpoint.isUnix) {
+            const int noDelay = 1;
+            setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &noDelay, sizeof(noDelay));
+        }
+
+        auto session = std::make_unique<Session>();
+        session->id = m_nextId++;
+        session->fd = fd;
+
+        epoll_event event{};
+        event.events = session->interest;
+        event.data.u64 = session->id;
+        if (epoll_ctl(m_epollFd, EPOLL_CTL_ADD, fd, &event) < 0) {
+            ::close(fd);
+            continue;
+        }
+        m_sessions.emplace(session->id, std::move(session));
+    }
+}
+
+void GameServer::onReadable(Session &session) {
+    char buffer[4096];
+    while (!session.closed && !session.readClosed) {
+        const ssize_t count = read(session.fd, buffer, sizeof(buffer));
+        if (count == 0) { // clientul nu mai trimite nimic; ii trimit ce mai am de trimis, apoi inchid
+            session.readClosed = true;
+            session.closing = true;
+            break;
+        }
+        if (count < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            if (errno != EAGAIN && errno != EWOULDBLOCK) {
+                close(session);
+            }
+            break;
+        }
+
+        if (session.watching) { // spectatorii nu trimit taste
+            continue;
+        }
+
+        std::size_t offset = 0;
+        if (!session.game) {
+            while (offset < (std::size_t) count && buffer[offset] != '\n') {
+                if (session.sizeLine.size() < 32 && buffer[offset] != '\r') {
+                    session.sizeLine += buffer[offset];
+                }
+                ++offset;
+            }
+            if (offset == (std::size_t) count) { // linia cu dimensiunea nu s-a terminat inca
+                continue;
+            }
+            ++offset; // '\n'
+
+            if (session.sizeLine.starts_with("watch ")) {
+                std::uint64_t gameId = 0;
+                try {
+                    gameId = std::stoull(session.sizeLine.substr(6));
+                }
+                catch (const std::exception &) {
+                    // id invalid, deci nu exista o astfel de sesiune
+                }
+                watch(session, gameId);
+                continue;
+            }
+
+            int mazeSize = 25;
+            try {
+                mazeSize = std::stoi(session.sizeLine);
+            }
+            catch (const std::exception &) {
+                // la fel ca in consola, o dimensiune invalida inseamna dimensiunea implicita
+            }
+            startGame(session, std::clamp(mazeSize, 10, 30));
+        }
+
+        if (offset < (std::size_t) count && !session.closing) {
+            handleKeys(session, buffer + offset, (std::size_t) count - offset);
+        }
+    }
+
+    if (session.closed) {
+        return;
+    }
+    if (session.watching) {
+        flushSpectator(session);
+    }
+    else {
+        flush(session);
+    }
+}
+
+void GameServer::onWritable(Session &session) {
+    if (session.watching) {
+        flushSpectator(session);
+    }
+    else {
+        flush(session);
+    }
+}
+
+void GameServer::startGame(Session &session, const int mazeSize) {
+    session.game = std::make_unique<Game>(mazeSize);
+    session.game->setFrameSink([&session](const std::string &frame) { session.outbox += frame; });
+    session.game->start(Clock::now());
+    session.game->render();
+    scheduleWake(session);
+}
+
+void GameServer::watch(Session &session, const std::uint64_t gameId) {
+    const auto it = m_sessions.find(gameId);
+    if (it == m_sessions.end() || !it->second->game || it->second->closing || it->second->closed) {
+        close(session);
+        return;
+    }
+
+    Session &target = *it->second;
+    if (!target.spectators) {
+        target.spectators = std::make_unique<Broadcast>(m_maxSpectatorBytes);
+    }
+    session.watching = gameId;
+    session.subscriber.id = session.id;
+    session.subscriber.fd = session.fd;
+    target.spectators->add(session.subscriber);
+    publishState(target); // spectatorul nou primeste un keyframe
+}
+
+void GameServer::publishState(Session &session) {
+    if (!session.spectators || session.spectators->subscribers().empty()) {
+        return;
+    }
+
+    session.game->syncState(session.syncState);
+    if (session.spectators->needsKeyframe()) {
+        session.encoder.requestKeyframe();
+    }
+    std::vector<std::uint8_t> message;
+    if (!session.encoder.encode(session.syncState, message)) { // nimic nou de la ultimul mesaj
+        return;
+    }
+
+    // mesajul este incadrat o singura data, indiferent de numarul spectatorilor
+    auto frame = std::make_shared<std::vector<std::uint8_t>>();
+    frame->reserve(message.size() + 3);
+    writeVarint(*frame, message.size());
+    frame->insert(frame->end(), message.begin(), message.end());
+    session.spectators->publish(frame, session.encoder.lastWasKeyframe());
+
+    // copie, pentru ca un spectator inchis in flushSpectator se scoate singur din lista
+    const std::vector<Broadcast::Subscriber *> subscribers = session.spectators->subscribers();
+    for (const Broadcast::Subscriber *subscriber: subscribers) {
+        const auto it = m_sessions.find(subscriber->id);
+        if (it != m_sessions.end() && !it->second->closed) {
+            flushSpectator(*it->second);
+        }
+    }
+}
+
+void GameServer::flushSpectator(Session &session) {
+    const Broadcast::FlushResult result = Broadcast::flush(session.subscriber);
+    if (result == Broadcast::FlushResult::Failed ||
+        (result == Broadcast::FlushResult::Done && session.closing)) {
+        close(session);
+        return;
+    }
+    updateInterest(session);
+}
+
+void GameServer::handleKeys(Session &session, const char *keys, const std::size_t count) {
+    Game &game = *session.game;
+    const Clock::time_point now = Clock::now();
+
+    // toate tastele primite deodata sunt procesate fara afisare si se trimite un singur cadru la final
+    game.setRenderEnabled(false);
+    for (std::size_t i = 0; i < count && game.isRunning(); i++) {
+        if (keys[i] != '\r' && keys[i] != '\n') {
+            game.step(now, (unsigned char) keys[i]);
+        }
+    }
+    game.setRenderEnabled(true);
+
+    if (!game.isRunning()) {
+        finishGame(session);
+        return;
+    }
+    game.render();
+    publishState(session);
+    scheduleWake(session);
+}
+
+void GameServer::finishGame(Session &session) {
+    if (session.hasTimer) {
+        m_timers.cancel(session.timerId);
+        session.hasTimer = false;
+    }
+    publishState(session); // spectatorii primesc starea finala si sunt deconectati odata cu jucatorul
+    session.outbox += rlutil::ANSI_CLS;
+    session.outbox += rlutil::ANSI_CURSOR_HOME;
+    session.outbox += session.game->resultMessage() + "\n";
+    session.closing = true;
+    flush(session);
+}
+
+void GameServer::scheduleWake(Session &session) {
+    if (session.hasTimer) {
+        m_timers.cancel(session.timerId);
+    }
+
+    const Clock::duration delay = session.game->nextDeadline() - Clock::now();
+    session.timerId = m_timers.schedule(std::max(delay, Clock::duration::zero()), [this, id = session.id]() {
+        const auto it = m_sessions.find(id);
+        if (it == m_sessions.end() || it->second->closed) {
+            return;
+        }
+        Session &woken = *it->second;
+        woken.hasTimer = false;
+        woken.game->advance(Clock::now());
+        publishState(woken);
+        if (!woken.game->isRunning()) {
+            finishGame(woken);
+            return;
+        }
+        scheduleWake(woken);
+        flush(woken);
+    });
+    session.hasTimer = true;
+}
+
+void GameServer::flush(Session &session) {
+    while (session.sent < session.outbox.size()) {
+        const ssize_t count = send(session.fd, session.outbox.data() + session.sent, session.outbox.size() - session.sent,
+                                   MSG_NOSIGNAL);
+        if (count < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            if (errno == EAGAIN || errno == EWOULDBLOCK) {
+                break;
+            }
+            close(session);
+            return;
+        }
+        session.sent += (std::size_t) count;
+    }
+
+    if (session.sent == session.outbox.size()) {
+        session.outbox.clear();
+        session.sent = 0;
+        if (session.closing) {
+            close(session);
+            return;
+        }
+    }
+    else if (session.outbox.size() - session.sent > m_maxPendingBytes) { // clientul nu citeste; nu tin cadre la infinit
+        close(session);
+        return;
+    }
+
+    updateInterest(session);
+}
+
+void GameServer::updateInterest(Session &session) {
+    const bool pending = session.sent < session.outbox.size() || session.subscriber.hasPending();
+    const std::uint32_t interest = (session.readClosed ? 0u : (std::uint32_t) EPOLLIN) |
+                                   (pending ? (std::uint32_t) EPOLLOUT : 0u);
+    if (session.interest == interest) {
+        return;
+    }
+    epoll_event event{};
+    event.events = interest;
+    event.data.u64 = session.id;
+    epoll_ctl(m_epollFd, EPOLL_CTL_MOD, session.fd, &event);
+    session.interest = interest;
+}
+
+void GameServer::close(Session &session) {
+    if (session.closed) {
+        return;
+    }
+    if (session.hasTimer) {
+        m_timers.cancel(session.timerId);
+        session.hasTimer = false;
+    }
+    epoll_ctl(m_epollFd, EPOLL_CTL_DEL, session.fd, nullptr);
+    ::close(session.fd);
+    session.closed = true;
+    m_closed.push_back(session.id);
+
+    if (session.watching) {
+        const auto it = m_sessions.find(session.watching);
+        if (it != m_sessions.end() && it->second->spectators) {
+            it->second->spectators->remove(session.subscriber);
+        }
+    }
+
+    if (session.spectators) { // spectatorii primesc ce mai au in coada, apoi sunt inchisi
+        const std::unique_ptr<Broadcast> spectators = std::move(session.spectators);
+        for (const Broadcast::Subscriber *subscriber: spectators->subscribers()) {
+            const auto it = m_sessions.find(subscriber->id);
+            if (it != m_sessions.end() && !it->second->closed) {
+                it->second->closing = true;
+                flushSpectator(*it->second);
+            }
+        }
+    }
+}
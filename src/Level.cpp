@@ -0,0 +1,261 @@
+#include "Level.h"
+
+#include <algorithm>
+#include <limits>
+
+#include "ApplePlacement.h"
+#include "BakedLevel.h"
+#include "FixedMaze.h"
+#include "Sidewinder.h"
+#include "SplitMix64.h"
+#include "Varint.h"
+
+namespace {
+    constexpr char magic[4] = {'N', 'I', 'T', 'L'};
+    constexpr std::uint8_t formatVersion = 1;
+    constexpr std::uint64_t maxDim = 4096;
+
+    bool readInt(const std::vector<std::uint8_t> &in, std::size_t &pos, const std::uint64_t limit, int &value) {
+        std::uint64_t raw = 0;
+        if (!readVarint(in, pos, raw) || raw > limit) {
+            return false;
+        }
+        value = (int) raw;
+        return true;
+    }
+
+    void writeCells(std::vector<std::uint8_t> &out, const std::vector<std::pair<int, int>> &cells, const int dim) {
+        writeVarint(out, cells.size());
+        for (const auto &[row, col]: cells) {
+            writeVarint(out, (std::uint64_t) row * dim + col);
+        }
+    }
+
+    bool readCells(const std::vector<std::uint8_t> &in, std::size_t &pos, const int dim,
+                   std::vector<std::pair<int, int>> &cells) {
+        int count = 0;
+        if (!readInt(in, pos, (std::uint64_t) dim * dim, count)) {
+            return false;
+        }
+        cells.clear();
+        for (int i = 0; i < count; i++) {
+            int index = 0;
+            if (!readInt(in, pos, (std::uint64_t) dim * dim - 1, index)) {
+                return false;
+            }
+            cells.emplace_back(index / dim, index % dim);
+        }
+        return true;
+    }
+
+    // BFS pentru dimensiunile fara FixedMaze: peretii copiati o data, cu o bordura de ziduri, ca vecinii sa fie
+    // cell +- 1 si cell +- stride fara verificari de margini (la 1000 x 1000 analiza face ~60 de BFS-uri complete)
+    class PaddedGrid {
+    public:
+        explicit PaddedGrid(const Level &level)
+                : m_dim(level.dim), m_stride(level.dim + 2), m_open((std::size_t) m_stride * m_stride),
+                  m_distance(m_open.size()), m_queue(m_open.size() + 1) {
+            for (int row = 0; row < m_dim; row++) {
+                for (int col = 0; col < m_dim; col++) {
+                    m_open[cell(row, col)] = !level.wall[(std::size_t) row * m_dim + col];
+                }
+            }
+        }
+
+        std::vector<std::int32_t> distancesFrom(const int row, const int col) {
+            const std::int32_t offsets[4] = {-m_stride, -1, m_stride, 1};
+            std::fill(m_distance.begin(), m_distance.end(), -1);
+            std::size_t head = 0, tail = 0;
+            m_distance[cell(row, col)] = 0;
+            m_queue[tail++] = cell(row, col);
+            while (head < tail) {
+                const std::int32_t current = m_queue[head++];
+                const std::int32_t step = m_distance[current] + 1;
+                for (const std::int32_t offset: offsets) {
+                    // fara ramificatii, ca in FixedMaze::distancesFrom
+                    const std::int32_t next = current + offset;
+                    const bool discovered = m_open[next] & (m_distance[next] < 0);
+                    m_distance[next] = discovered ? step : m_distance[next];
+                    m_queue[tail] = next;
+                    tail += discovered;
+                }
+            }
+
+            std::vector<std::int32_t> result((std::size_t) m_dim * m_dim);
+            for (int r = 0; r < m_dim; r++) {
+                std::copy_n(m_distance.begin() + cell(r, 0), m_dim, result.begin() + (std::ptrdiff_t) r * m_dim);
+            }
+            return result;
+        }
+
+    private:
+        [[nodiscard]] std::int32_t cell(const int row, const int col) const {
+            return (row + 1) * m_stride + col + 1;
+        }
+
+        int m_dim;
+        int m_stride;
+        std::vector<std::uint8_t> m_open;
+        std::vector<std::int32_t> m_distance;
+        std::vector<std::int32_t> m_queue;
+    };
+}
+
+Level Level::generate(const int dim, const std::uint64_t seed) {
+    Level level = generateLayout(dim, seed);
+    level.analyze();
+    return level;
+}
+
+Level Level::generateLayout(const int dim, const std::uint64_t seed) {
+    // dimensiunile din meniu folosesc exact codul nivelurilor coapte la compilare
+    return dispatchMazeSize(dim, [seed](auto size) { return bakeLevel<size>(seed).layout(); }, [dim, seed]() {
+        SplitMix64 rng{seed};
+        Level level;
+        level.dim = dim;
+        level.seed = seed;
+
+        // acelasi labirint ca Maze::generate(rng()), sapat direct in wall
+        level.wall.assign((std::size_t) dim * dim, 1);
+        SplitMix64 mazeRng{rng()};
+        carveSidewinder(dim, [&mazeRng](const int from, const int to) { return uniformInt(mazeRng, from, to); },
+                        [&level, dim](const int row, const int col) { level.wall[(std::size_t) row * dim + col] = 0; });
+
+        // celulele libere ca Maze::getFreeCells (fara randul 0)
+        std::vector<std::pair<int, int>> freeCells;
+        for (int row = 1; row < dim; row++) {
+            for (int col = 0; col < dim; col++) {
+                if (!level.wall[(std::size_t) row * dim + col]) {
+                    freeCells.emplace_back(row, col);
+                }
+            }
+        }
+        placeApplesOnFreeCells((int) freeCells.size(), [&rng](const int from, const int to) { return uniformInt(rng, from, to); },
+                               [&level, &freeCells](const int index) { level.apples.push_back(freeCells[index]); });
+
+        level.bombCol = uniformInt(rng, 2, dim - 2);
+        return level;
+    });
+}
+
+template<typename DistancesFrom>
+void Level::analyzeRoute(const DistancesFrom &bfs) {
+    distance = bfs(0, 0);
+
+    // traseul de referinta: de fiecare data cel mai apropiat mar ramas (la egalitate, primul din lista), apoi iesirea
+    std::vector<std::pair<int, int>> remaining;
+    for (const auto &[row, col]: apples) {
+        if (distance[(std::size_t) row * dim + col] >= 0) {
+            remaining.emplace_back(row, col);
+        }
+    }
+    reachableApples = (int) remaining.size();
+    parRoute.clear();
+    parLength = 0;
+
+    std::vector<std::int32_t> fromCurrent = distance;
+    while (!remaining.empty()) {
+        const auto nearest = std::min_element(remaining.begin(), remaining.end(), [&](const auto &a, const auto &b) {
+            return fromCurrent[(std::size_t) a.first * dim + a.second] < fromCurrent[(std::size_t) b.first * dim + b.second];
+        });
+        parLength += fromCurrent[(std::size_t) nearest->first * dim + nearest->second];
+        parRoute.push_back(*nearest);
+        fromCurrent = bfs(nearest->first, nearest->second);
+        remaining.erase(nearest);
+    }
+    parLength += fromCurrent[0]; // inapoi la (0, 0)
+}
+
+void Level::analyze() {
+    components = 0;
+    std::vector<std::uint8_t> seen(wall.size());
+    std::vector<int> stack;
+    for (int cell = 0; cell < (int) wall.size(); cell++) {
+        if (wall[cell] || seen[cell]) {
+            continue;
+        }
+        ++components;
+        seen[cell] = 1;
+        stack.push_back(cell);
+        while (!stack.empty()) { // umplerea componentei
+            const int current = stack.back();
+            stack.pop_back();
+            const int r = current / dim;
+            const int c = current % dim;
+            const int neighbours[4][2] = {{r - 1, c}, {r, c - 1}, {r + 1, c}, {r, c + 1}};
+            for (const auto &[nr, nc]: neighbours) {
+                const int next = nr * dim + nc;
+                if (nr >= 0 && nc >= 0 && nr < dim && nc < dim && !wall[next] && !seen[next]) {
+                    seen[next] = 1;
+                    stack.push_back(next);
+                }
+            }
+        }
+    }
+
+    dispatchMazeSize(dim, [this](auto size) {
+        FixedMaze<size, size> maze;
+        maze.assign(wall);
+        analyzeRoute([&maze](const int row, const int col) { return maze.distancesFrom(row, col); });
+    }, [this]() {
+        PaddedGrid grid{*this};
+        analyzeRoute([&grid](const int row, const int col) { return grid.distancesFrom(row, col); });
+    });
+}
+
+std::vector<std::uint8_t> Level::serialize() const {
+    std::vector<std::uint8_t> out(magic, magic + sizeof(magic));
+    out.push_back(formatVersion);
+    writeVarint(out, (std::uint64_t) dim);
+    writeVarint(out, seed);
+    writeBitset(out, wall);
+    writeCells(out, apples, dim);
+    writeVarint(out, (std::uint64_t) bombCol);
+
+    writeVarint(out, (std::uint64_t) components);
+    for (const std::int32_t steps: distance) {
+        writeVarint(out, (std::uint64_t) (steps + 1));
+    }
+    writeVarint(out, (std::uint64_t) reachableApples);
+    writeCells(out, parRoute, dim);
+    writeVarint(out, (std::uint64_t) parLength);
+    return out;
+}
+
+bool Level::deserialize(const std::vector<std::uint8_t> &data, Level &level) {
+    if (data.size() < sizeof(magic) + 1 || !std::equal(magic, magic + sizeof(magic), data.begin()) ||
+        data[sizeof(magic)] != formatVersion) {
+        return false;
+    }
+
+    std::size_t pos = sizeof(magic) + 1;
+    Level result;
+    if (!readInt(data, pos, maxDim, result.dim) || result.dim < 4 || !readVarint(data, pos, result.seed)) {
+        return false;
+    }
+    const std::uint64_t cells = (std::uint64_t) result.dim * result.dim;
+
+    result.wall.resize(cells);
+    if (!readBitset(data, pos, result.wall) || !readCells(data, pos, result.dim, result.apples) ||
+        !readInt(data, pos, (std::uint64_t) result.dim, result.bombCol) ||
+        !readInt(data, pos, cells, result.components)) {
+        return false;
+    }
+
+    result.distance.resize(cells);
+    for (std::int32_t &steps: result.distance) {
+        int stored = 0;
+        if (!readInt(data, pos, cells, stored)) {
+            return false;
+        }
+        steps = stored - 1;
+    }
+
+    if (!readInt(data, pos, cells, result.reachableApples) || !readCells(data, pos, result.dim, result.parRoute) ||
+        !readInt(data, pos, (std::uint64_t) std::numeric_limits<int>::max(), result.parLength) || pos != data.size()) {
+        return false;
+    }
+
+    level = std::move(result);
+    return true;
+}
@@ -0,0 +1,139 @@
+#include "LevelCache.h"
+
+#include <fstream>
+#include <functional>
+#include <iterator>
+#include <system_error>
+#include <thread>
+#include <vector>
+#include <digestpp.hpp>
+
+namespace {
+    std::string contentDigest(const std::vector<std::uint8_t> &data) {
+        return digestpp::sha3(256).absorb(data.data(), data.size()).hexdigest();
+    }
+
+    bool readFile(const std::filesystem::path &path, std::vector<std::uint8_t> &data) {
+        std::ifstream in(path, std::ios::binary);
+        if (!in) {
+            return false;
+        }
+        data.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+        return !in.bad();
+    }
+
+    // scrie intr-un fisier temporar si il redenumeste, ca un alt proces sa nu vada niciodata un fisier pe jumatate
+    void writeFile(const std::filesystem::path &path, const char *data, const std::size_t size) {
+        const std::filesystem::path temporary = path.string() + ".tmp" + std::to_string(std::hash<std::thread::id>{}(std::this_thread::get_id()));
+        {
+            std::ofstream out(temporary, std::ios::binary | std::ios::trunc);
+            out.write(data, (std::streamsize) size);
+            if (!out) {
+                return; // cache-ul este doar o optimizare; nivelul se regenereaza data viitoare
+            }
+        }
+        std::error_code error;
+        std::filesystem::rename(temporary, path, error);
+        if (error) {
+            std::filesystem::remove(temporary, error);
+        }
+    }
+}
+
+LevelCache::LevelCache(std::filesystem::path directory, const std::size_t memoryEntries)
+        : m_directory(std::move(directory)), m_memoryEntries(memoryEntries) {
+    std::filesystem::create_directories(m_directory / "keys");
+    std::filesystem::create_directories(m_directory / "objects");
+}
+
+std::string LevelCache::key(const int dim, const std::uint64_t seed) {
+    return digestpp::blake2b(256)
+            .absorb(std::string(Level::generatorName) + '/' + std::to_string(dim) + '/' + std::to_string(seed))
+            .hexdigest();
+}
+
+std::shared_ptr<const Level> LevelCache::get(const int dim, const std::uint64_t seed) {
+    const MemoryKey memoryKey{dim, seed};
+    {
+        const std::lock_guard lock(m_mutex);
+        const auto it = m_memory.find(memoryKey);
+        if (it != m_memory.end()) {
+            ++m_stats.memoryHits;
+            m_order.splice(m_order.end(), m_order, it->second.position); // O(1), iteratorul ramane valid
+            return it->second.level;
+        }
+    }
+
+    // citirea si generarea se fac fara lock; doua thread-uri care cer acelasi nivel il pot genera amandoua
+    const std::string levelKey = key(dim, seed);
+    std::shared_ptr<const Level> level = load(levelKey);
+    if (level && level->dim == dim && level->seed == seed) {
+        const std::lock_guard lock(m_mutex);
+        ++m_stats.diskHits;
+    }
+    else {
+        level = std::make_shared<const Level>(Level::generate(dim, seed));
+        store(levelKey, *level);
+        const std::lock_guard lock(m_mutex);
+        ++m_stats.generated;
+    }
+
+    remember(memoryKey, level);
+    return level;
+}
+
+std::shared_ptr<const Level> LevelCache::load(const std::string &key) const {
+    std::vector<std::uint8_t> name;
+    if (!readFile(m_directory / "keys" / key, name)) {
+        return nullptr;
+    }
+    const std::string object(name.begin(), name.end());
+
+    std::vector<std::uint8_t> data;
+    Level level;
+    if (object.find('/') != std::string::npos || !readFile(m_directory / "objects" / object, data)) {
+        return nullptr;
+    }
+    if (contentDigest(data) != object || !Level::deserialize(data, level)) { // obiect stricat; se rescrie la store()
+        std::error_code error;
+        std::filesystem::remove(m_directory / "objects" / object, error);
+        return nullptr;
+    }
+    return std::make_shared<const Level>(std::move(level));
+}
+
+void LevelCache::store(const std::string &key, const Level &level) const {
+    const std::vector<std::uint8_t> data = level.serialize();
+    const std::string object = contentDigest(data);
+
+    const std::filesystem::path objectPath = m_directory / "objects" / object;
+    std::error_code error;
+    if (!std::filesystem::exists(objectPath, error)) { // acelasi continut se salveaza o singura data
+        writeFile(objectPath, reinterpret_cast<const char *>(data.data()), data.size());
+    }
+    writeFile(m_directory / "keys" / key, object.data(), object.size());
+}
+
+void LevelCache::remember(const MemoryKey &key, const std::shared_ptr<const Level> &level) {
+    const std::lock_guard lock(m_mutex);
+    if (m_memoryEntries == 0 || m_memory.contains(key)) { // alt thread l-a adus intre timp
+        return;
+    }
+    m_order.push_back(key);
+    m_memory.emplace(key, MemoryEntry{level, std::prev(m_order.end())});
+    if (m_order.size() > m_memoryEntries) {
+        m_memory.erase(m_order.front());
+        m_order.pop_front();
+    }
+}
+
+LevelCache::Stats LevelCache::stats() const {
+    const std::lock_guard lock(m_mutex);
+    return m_stats;
+}
+
+void LevelCache::clearMemory() {
+    const std::lock_guard lock(m_mutex);
+    m_memory.clear();
+    m_order.clear();
+}
@@ -0,0 +1,112 @@
+#include "LevelPipeline.h"
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
+#include "DifficultyTable.h"
+
+namespace {
+    constexpr int minApples = 5;
+}
+
+LevelPipeline::LevelPipeline(const int dim, const std::uint64_t seed, const std::size_t depth, LevelCache *cache)
+        : m_dim(dim), m_seed(seed), m_depth(std::max<std::size_t>(depth, 1)), m_cache(cache),
+          m_pool(&ThreadPool::shared()) {
+    if (m_pool->workerCount() == 0) {
+        ThreadPool::Config config;
+        config.threads = 1;
+        config.background = true;
+        m_ownPool = std::make_unique<ThreadPool>(config);
+        m_pool = m_ownPool.get();
+    }
+
+    const std::lock_guard lock(m_mutex);
+    refill();
+}
+
+LevelPipeline::~LevelPipeline() {
+    std::unique_lock lock(m_mutex);
+    m_changed.wait(lock, [this]() { return m_inFlight == 0; });
+}
+
+std::chrono::seconds LevelPipeline::timeLimit(const Level &level) {
+    return DifficultyTable::shared().timeLimit(level);
+}
+
+std::uint64_t LevelPipeline::levelSeed(const std::uint64_t seed, const std::uint64_t index, const int attempt) {
+    // seed-uri diferite, derivate determinist din seed-ul campaniei
+    return seed ^ (index * 0xD1B54A32D192ED03ULL) ^ ((std::uint64_t) attempt << 56);
+}
+
+bool LevelPipeline::isPlayable(const Level &level) {
+    return (int) level.apples.size() >= minApples && level.reachableApples == (int) level.apples.size();
+}
+
+std::shared_ptr<const Level> LevelPipeline::load(const std::uint64_t seed) const {
+    if (m_cache) {
+        try {
+            return m_cache->get(m_dim, seed);
+        }
+        catch (const std::exception &) {
+            // cache-ul este doar o optimizare; nivelul se genereaza mai jos
+        }
+    }
+    return std::make_shared<const Level>(Level::generate(m_dim, seed));
+}
+
+PreparedLevel LevelPipeline::prepare(const std::uint64_t index) const {
+    for (int attempt = 0; attempt < maxAttempts; attempt++) {
+        std::shared_ptr<const Level> level = load(levelSeed(m_seed, index, attempt));
+        if (isPlayable(*level)) {
+            return PreparedLevel{level, timeLimit(*level)};
+        }
+    }
+    throw std::runtime_error("no playable " + std::to_string(m_dim) + "x" + std::to_string(m_dim) + " level " +
+                             std::to_string(index) + " after " + std::to_string(maxAttempts) + " seeds");
+}
+
+void LevelPipeline::refill() {
+    while (m_issued - m_next < m_depth) {
+        const std::uint64_t index = m_issued++;
+        ++m_inFlight;
+        m_pool->submit([this, index]() {
+            Result result;
+            try {
+                result.prepared = prepare(index);
+            }
+            catch (...) { // o exceptie scapata dintr-un worker ar opri programul si ar bloca next()
+                result.error = std::current_exception();
+            }
+            const std::lock_guard lock(m_mutex);
+            m_ready.emplace(index, std::move(result));
+            --m_inFlight;
+            m_changed.notify_all();
+        });
+    }
+}
+
+PreparedLevel LevelPipeline::next() {
+    std::unique_lock lock(m_mutex);
+    m_changed.wait(lock, [this]() { return m_ready.contains(m_next); });
+
+    const auto it = m_ready.find(m_next);
+    Result result = std::move(it->second);
+    m_ready.erase(it);
+    ++m_next;
+    refill();
+    if (result.error) {
+        std::rethrow_exception(result.error);
+    }
+    return result.prepared;
+}
+
+std::size_t LevelPipeline::ready() const {
+    const std::lock_guard lock(m_mutex);
+    return m_ready.size();
+}
+
+std::uint64_t LevelPipeline::levelIndex() const {
+    const std::lock_guard lock(m_mutex);
+    return m_next;
+}
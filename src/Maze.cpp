@@ -0,0 +1,105 @@
+#include "Maze.h"
+
+#include <random.hpp>
+
+#include "Sidewinder.h"
+#include "SplitMix64.h"
+#include "Zobrist.h"
+
+template<typename Layout>
+void BasicMaze<Layout>::print(std::ostream &out) const {
+    for (int row = 0; row < m_dim; row++) {
+        for (int col = 0; col < m_dim; col++) {
+            out << m_maze[m_layout.index(row, col)];
+        }
+        out << std::endl;
+    }
+}
+
+template<typename Layout>
+void BasicMaze<Layout>::createHole(const int row, const int col) { // cand a fost bomba folosita se distrug cei 8 vecini din jurul jucatorului
+    // drdc = vector de directii (cei 8 vecini ai punctului (row, col))
+    const int drdc[8][2] = {{-1, -1}, // (row-1, col-1)
+                            {-1, 0}, // (row-1, col)
+                            {-1, 1}, // (row-1, col+1)
+                            {0,  1}, // (row, col+1)
+                            {1,  1}, // (row+1, col+1)
+                            {1,  0}, // (row+1, col)
+                            {1,  -1}, // (row+1, col - 1)
+                            {0,  -1}}; // (row, col-1)
+
+    for (const auto &direction: drdc) { // cppcheck-suppress constVariable
+        const int newRow = row + direction[0];
+        const int newCol = col + direction[1];
+        if (isInside(newRow, newCol) && m_maze[m_layout.index(newRow, newCol)] == '#') {
+            m_maze[m_layout.index(newRow, newCol)] = ' ';
+            m_hash ^= Zobrist::cell(Zobrist::Feature::Wall, m_dim, newRow, newCol);
+        }
+    }
+}
+
+template<typename Layout>
+std::vector<std::pair<int, int>> BasicMaze<Layout>::getFreeCells() { // cauta toate locurile libere din labirint
+    std::vector<std::pair<int, int>> result;
+    for (int row = 1; row < m_dim; row++) {
+        for (int col = 0; col < m_dim; col++)
+            if (m_maze[m_layout.index(row, col)] == ' ') {
+                result.emplace_back(row, col);
+            }
+    }
+    return result;
+}
+
+template<typename Layout>
+void BasicMaze<Layout>::generate() { // Pentru generarea labirintului a fost folosit algoritmul Sidewinder
+    carveSidewinder(m_dim,
+                    [](const int from, const int to) { return effolkronium::random_static::get(from, to); },
+                    [this](const int row, const int col) { m_maze[m_layout.index(row, col)] = ' '; });
+    m_hash = computeHash();
+}
+
+template<typename Layout>
+void BasicMaze<Layout>::generate(const std::uint64_t seed) {
+    SplitMix64 rng{seed};
+    carveSidewinder(m_dim,
+                    [&rng](const int from, const int to) { return uniformInt(rng, from, to); },
+                    [this](const int row, const int col) { m_maze[m_layout.index(row, col)] = ' '; });
+    m_hash = computeHash();
+}
+
+template<typename Layout>
+int BasicMaze<Layout>::getSize() const {
+    return m_dim;
+}
+
+template<typename Layout>
+std::uint64_t BasicMaze<Layout>::getHash() const {
+    return m_hash;
+}
+
+template<typename Layout>
+std::uint64_t BasicMaze<Layout>::computeHash() const {
+    std::uint64_t hash = 0;
+    for (int row = 0; row < m_dim; row++) {
+        for (int col = 0; col < m_dim; col++) {
+            if (m_maze[m_layout.index(row, col)] == '#') {
+                hash ^= Zobrist::cell(Zobrist::Feature::Wall, m_dim, row, col);
+            }
+        }
+    }
+    return hash;
+}
+
+template<typename Layout>
+void BasicMaze<Layout>::assign(const std::vector<std::uint8_t> &wall) {
+    for (int row = 0; row < m_dim; row++) {
+        for (int col = 0; col < m_dim; col++) {
+            m_maze[m_layout.index(row, col)] = wall[(std::size_t) row * m_dim + col] ? '#' : ' ';
+        }
+    }
+    m_hash = computeHash();
+}
+
+template class BasicMaze<RowMajorLayout>;
+template class BasicMaze<TiledLayout>;
+template class BasicMaze<MortonLayout>;
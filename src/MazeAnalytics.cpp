@@ -0,0 +1,248 @@
+#include "MazeAnalytics.h"
+
+#include <algorithm>
+#include <bit>
+#include <chrono>
+#include <ostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <csv.hpp>
+
+namespace {
+    int corridorBucket(const std::int32_t length) { // length >= 2
+        return std::min((int) std::bit_width((std::uint32_t) length - 1), MazeMetrics::corridorBuckets) - 1;
+    }
+
+    double ratio(const std::uint64_t part, const std::uint64_t whole) {
+        return whole > 0 ? (double) part / (double) whole : 0.0;
+    }
+
+    std::string format(const double value) { // 6 cifre semnificative, ca un stream neconfigurat
+        std::ostringstream out;
+        out << value;
+        return out.str();
+    }
+}
+
+MazeMetrics &MazeMetrics::operator+=(const MazeMetrics &other) {
+    mazes += other.mazes;
+    cells += other.cells;
+    freeCells += other.freeCells;
+    deadEnds += other.deadEnds;
+    junctions += other.junctions;
+    junctionExits += other.junctionExits;
+    horizontalLinks += other.horizontalLinks;
+    verticalLinks += other.verticalLinks;
+    topRowFree += other.topRowFree;
+    for (int bucket = 0; bucket < corridorBuckets; bucket++) {
+        horizontalCorridors[bucket] += other.horizontalCorridors[bucket];
+        verticalCorridors[bucket] += other.verticalCorridors[bucket];
+    }
+    horizontalCorridorCells += other.horizontalCorridorCells;
+    verticalCorridorCells += other.verticalCorridorCells;
+    solved += other.solved;
+    solutionSteps += other.solutionSteps;
+    unreachableCells += other.unreachableCells;
+    apples += other.apples;
+    applesNeedingBomb += other.applesNeedingBomb;
+    levelsNeedingBomb += other.levelsNeedingBomb;
+    return *this;
+}
+
+MazeMetrics MazeAnalyzer::analyze(const Level &level) {
+    MazeMetrics metrics;
+    metrics.mazes = 1;
+    metrics.cells = (std::uint64_t) level.dim * level.dim;
+    assign(level);
+    scanCells(metrics);
+    searchFromExit(level, metrics);
+    return metrics;
+}
+
+void MazeAnalyzer::assign(const Level &level) {
+    m_dim = level.dim;
+    m_stride = m_dim + 2;
+    m_open.assign((std::size_t) m_stride * m_stride, 0);
+    for (int row = 0; row < m_dim; row++) {
+        const std::uint8_t *const walls = level.wall.data() + (std::size_t) row * m_dim;
+        std::uint8_t *const open = m_open.data() + (std::size_t) (row + 1) * m_stride + 1;
+        for (int col = 0; col < m_dim; col++) {
+            open[col] = !walls[col];
+        }
+    }
+}
+
+void MazeAnalyzer::scanCells(MazeMetrics &metrics) {
+    // sumele stau in variabile locale: scrise direct in metrics, ar fi recitite dupa fiecare octet citit din m_open,
+    // pentru ca un std::uint8_t poate fi alias pentru orice. Lungimile coridoarelor care se termina pe rand se scriu
+    // fara ramificatii in m_corridorEnds (ca vecinii in coada BFS-ului) si se impart pe lungimi abia la capatul
+    // randului: un if pe capatul de coridor, adevarat in vreo 15% din celule, ar fi ghicit gresit des.
+    std::uint64_t freeCells = 0, deadEnds = 0, junctions = 0, junctionExits = 0, horizontalLinks = 0, verticalLinks = 0;
+    m_verticalRun.assign(m_dim, 0);
+    m_corridorEnds.resize(2 * (std::size_t) m_dim + 2);
+    for (int row = 0; row < m_dim; row++) {
+        const std::uint8_t *const open = m_open.data() + (std::size_t) (row + 1) * m_stride + 1;
+        std::int32_t *const verticalRun = m_verticalRun.data();
+        std::int32_t *const horizontalEnds = m_corridorEnds.data();
+        std::int32_t *const verticalEnds = horizontalEnds + m_dim + 1;
+        std::size_t horizontalCount = 0, verticalCount = 0;
+        std::int32_t horizontalRun = 0;
+        for (int col = 0; col < m_dim; col++) {
+            const int here = open[col];
+            const int right = open[col + 1], down = open[col + m_stride];
+            const int degree = here * (open[col - m_stride] + open[col - 1] + down + right);
+
+            freeCells += here;
+            deadEnds += degree == 1;
+            junctions += degree >= 3;
+            junctionExits += degree >= 3 ? degree - 1 : 0;
+            horizontalLinks += here & right;
+            verticalLinks += here & down;
+
+            // un coridor drept se termina in celula libera dupa care urmeaza zid
+            horizontalRun = here * (horizontalRun + 1);
+            const std::int32_t columnRun = here * (verticalRun[col] + 1);
+            verticalRun[col] = columnRun;
+            horizontalEnds[horizontalCount] = horizontalRun;
+            horizontalCount += (right == 0) & (horizontalRun >= 2);
+            verticalEnds[verticalCount] = columnRun;
+            verticalCount += (down == 0) & (columnRun >= 2);
+        }
+        for (std::size_t i = 0; i < horizontalCount; i++) {
+            metrics.horizontalCorridors[corridorBucket(horizontalEnds[i])]++;
+            metrics.horizontalCorridorCells += horizontalEnds[i];
+        }
+        for (std::size_t i = 0; i < verticalCount; i++) {
+            metrics.verticalCorridors[corridorBucket(verticalEnds[i])]++;
+            metrics.verticalCorridorCells += verticalEnds[i];
+        }
+        if (row == 0) {
+            metrics.topRowFree = freeCells;
+        }
+    }
+    metrics.freeCells = freeCells;
+    metrics.deadEnds = deadEnds;
+    metrics.junctions = junctions;
+    metrics.junctionExits = junctionExits;
+    metrics.horizontalLinks = horizontalLinks;
+    metrics.verticalLinks = verticalLinks;
+}
+
+void MazeAnalyzer::searchFromExit(const Level &level, MazeMetrics &metrics) {
+    const std::int32_t offsets[4] = {-m_stride, -1, m_stride, 1};
+    const auto cell = [this](const int row, const int col) { return (row + 1) * m_stride + col + 1; };
+
+    m_distance.assign(m_open.size(), -1);
+    m_queue.resize(m_open.size() + 1);
+    std::size_t head = 0, tail = 0;
+    if (m_open[cell(0, 0)]) {
+        m_distance[cell(0, 0)] = 0;
+        m_queue[tail++] = cell(0, 0);
+    }
+    while (head < tail) {
+        const std::int32_t current = m_queue[head++];
+        const std::int32_t step = m_distance[current] + 1;
+        for (const std::int32_t offset: offsets) {
+            // fara ramificatii, ca in FixedMaze::distancesFrom
+            const std::int32_t next = current + offset;
+            const bool discovered = m_open[next] & (m_distance[next] < 0);
+            m_distance[next] = discovered ? step : m_distance[next];
+            m_queue[tail] = next;
+            tail += discovered;
+        }
+    }
+    metrics.unreachableCells = metrics.freeCells - tail;
+
+    for (int col = m_dim - 1; col >= 0; col--) {
+        if (m_open[cell(m_dim - 1, col)]) {
+            const std::int32_t length = m_distance[cell(m_dim - 1, col)];
+            metrics.solved += length >= 0;
+            metrics.solutionSteps += std::max(length, 0);
+            break;
+        }
+    }
+
+    metrics.apples = level.apples.size();
+    for (const auto &[row, col]: level.apples) {
+        metrics.applesNeedingBomb += m_distance[cell(row, col)] < 0;
+    }
+    metrics.levelsNeedingBomb = metrics.applesNeedingBomb > 0;
+}
+
+AnalyticsResult analyzeMazes(const AnalyticsConfig &config, ThreadPool &pool) {
+    if (config.sizes.empty() || config.mazes < 1 ||
+        std::any_of(config.sizes.begin(), config.sizes.end(), [](const int size) { return size < 10; })) {
+        throw std::invalid_argument("invalid analytics config");
+    }
+
+    const auto started = std::chrono::steady_clock::now();
+    AnalyticsResult result;
+    for (const int size: config.sizes) {
+        // bucati de cateva milisecunde: la 10 x 10 mii de labirinte, la 1000 x 1000 unul singur
+        const std::int64_t grain = std::clamp<std::int64_t>(1000000 / ((std::int64_t) size * size), 1, 4096);
+        MazeMetrics metrics = pool.parallelReduce(
+                0, (std::int64_t) config.mazes, grain, MazeMetrics{},
+                [&](const std::int64_t begin, const std::int64_t end) {
+                    MazeAnalyzer analyzer;
+                    MazeMetrics partial;
+                    for (std::int64_t i = begin; i < end; i++) {
+                        partial += analyzer.analyze(Level::generateLayout(size, config.firstSeed + (std::uint64_t) i));
+                    }
+                    return partial;
+                },
+                [](MazeMetrics total, const MazeMetrics &partial) { return total += partial; });
+        result.rows.push_back(AnalyticsRow{size, metrics});
+    }
+    result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+    return result;
+}
+
+void writeAnalyticsCsv(std::ostream &out, const AnalyticsConfig &config, const AnalyticsResult &result) {
+    constexpr const char *buckets[MazeMetrics::corridorBuckets] = {"2", "3_4", "5_8", "9_16", "17_32", "33_plus"};
+    auto writer = csv::make_csv_writer(out);
+
+    std::vector<std::string> header{"generator", "size", "first_seed", "mazes", "free_cell_ratio", "dead_ends",
+                                    "junctions", "branching_factor", "horizontal_link_share", "top_row_open",
+                                    "mean_horizontal_corridor", "mean_vertical_corridor"};
+    for (const char *bucket: buckets) {
+        header.push_back(std::string("horizontal_corridors_") + bucket);
+    }
+    for (const char *bucket: buckets) {
+        header.push_back(std::string("vertical_corridors_") + bucket);
+    }
+    header.insert(header.end(), {"solved_rate", "solution_length", "unreachable_cell_ratio", "apples",
+                                 "apples_needing_bomb", "levels_needing_bomb"});
+    writer << header;
+
+    for (const AnalyticsRow &row: result.rows) {
+        const MazeMetrics &m = row.metrics;
+        std::uint64_t horizontalCount = 0, verticalCount = 0;
+        for (int bucket = 0; bucket < MazeMetrics::corridorBuckets; bucket++) {
+            horizontalCount += m.horizontalCorridors[bucket];
+            verticalCount += m.verticalCorridors[bucket];
+        }
+
+        // numaratorile sunt medii pe labirint, iar coridoarele pe lungimi sunt proportii din coridoarele directiei
+        std::vector<std::string> fields{
+                Level::generatorName, std::to_string(row.size), std::to_string(config.firstSeed),
+                std::to_string(m.mazes), format(ratio(m.freeCells, m.cells)), format(ratio(m.deadEnds, m.mazes)),
+                format(ratio(m.junctions, m.mazes)), format(ratio(m.junctionExits, m.junctions)),
+                format(ratio(m.horizontalLinks, m.horizontalLinks + m.verticalLinks)),
+                format(ratio(m.topRowFree, m.mazes * (std::uint64_t) row.size)),
+                format(ratio(m.horizontalCorridorCells, horizontalCount)),
+                format(ratio(m.verticalCorridorCells, verticalCount))};
+        for (const std::uint64_t count: m.horizontalCorridors) {
+            fields.push_back(format(ratio(count, horizontalCount)));
+        }
+        for (const std::uint64_t count: m.verticalCorridors) {
+            fields.push_back(format(ratio(count, verticalCount)));
+        }
+        fields.insert(fields.end(), {format(ratio(m.solved, m.mazes)), format(ratio(m.solutionSteps, m.solved)),
+                                     format(ratio(m.unreachableCells, m.freeCells)), format(ratio(m.apples, m.mazes)),
+                                     format(ratio(m.applesNeedingBomb, m.mazes)),
+                                     format(ratio(m.levelsNeedingBomb, m.mazes))});
+        writer << fields;
+    }
+}
@@ -0,0 +1,315 @@
+#include "NetClient.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+#include <rlutil.h>
+
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include "SplitMix64.h"
+#include "StateSync.h"
+#include "Varint.h"
+
+namespace {
+    bool sendAll(const int fd, const std::string &data) {
+        std::size_t sent = 0;
+        while (sent < data.size()) {
+            const ssize_t count = send(fd, data.data() + sent, data.size() - sent, MSG_NOSIGNAL);
+            if (count < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                if (errno == EAGAIN || errno == EWOULDBLOCK) { // socket neblocant plin: astept sa se elibereze
+                    pollfd writable{fd, POLLOUT, 0};
+                    poll(&writable, 1, 100);
+                    continue;
+                }
+                return false;
+            }
+            sent += (std::size_t) count;
+        }
+        return true;
+    }
+
+    // citeste tot ce este disponibil fara sa blocheze; intoarce false la EOF sau eroare
+    bool drain(const int fd, std::uint64_t &bytes) {
+        char buffer[16384];
+        while (true) {
+            const ssize_t count = recv(fd, buffer, sizeof(buffer), MSG_DONTWAIT);
+            if (count > 0) {
+                bytes += (std::uint64_t) count;
+                continue;
+            }
+            if (count < 0 && (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR)) {
+                return true;
+            }
+            return false;
+        }
+    }
+
+    // fluxul unui spectator: mesaje DeltaEncoder precedate de lungime (varint), aplicate pe masura ce sosesc
+    struct SpectatorStream {
+        int fd{-1};
+        std::vector<std::uint8_t> pending; // octeti primiti care nu formeaza inca un mesaj complet
+        DeltaDecoder decoder;
+        std::uint64_t bytes{};
+        std::uint64_t applied{};
+
+        // citeste fara sa blocheze; intoarce false la EOF sau eroare
+        bool read() {
+            std::uint8_t buffer[16384];
+            while (true) {
+                const ssize_t count = recv(fd, buffer, sizeof(buffer), MSG_DONTWAIT);
+                if (count > 0) {
+                    bytes += (std::uint64_t) count;
+                    pending.insert(pending.end(), buffer, buffer + count);
+                    continue;
+                }
+                parse();
+                return count < 0 && (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR);
+            }
+        }
+
+        void parse() {
+            std::size_t pos = 0;
+            while (true) {
+                std::size_t next = pos;
+                std::uint64_t length = 0;
+                if (!readVarint(pending, next, length) || pending.size() - next < length) {
+                    break;
+                }
+                const std::vector<std::uint8_t> message(pending.begin() + (std::ptrdiff_t) next,
+                                                        pending.begin() + (std::ptrdiff_t) (next + length));
+                applied += decoder.apply(message); // un delta ratat se recupereaza la urmatorul keyframe
+                pos = next + length;
+            }
+            pending.erase(pending.begin(), pending.begin() + (std::ptrdiff_t) pos);
+        }
+    };
+
+    void renderState(const SyncState &state, std::string &frame) {
+        frame.clear();
+        frame += rlutil::ANSI_CLS;
+        frame += rlutil::ANSI_CURSOR_HOME;
+
+        std::vector<int> playerAt(state.wall.size(), -1);
+        for (std::size_t i = 0; i < state.players.size(); i++) {
+            const SyncState::PlayerState &player = state.players[i];
+            if (player.row >= 0 && player.col >= 0 && player.row < state.dim && player.col < state.dim) { // vezi DeltaDecoder
+                playerAt[(std::size_t) player.row * state.dim + player.col] = (int) i;
+            }
+        }
+
+        for (int row = 0; row < state.dim; row++) {
+            for (int col = 0; col < state.dim; col++) {
+                const std::size_t cell = (std::size_t) row * state.dim + col;
+                if (playerAt[cell] >= 0) {
+                    frame += rlutil::getANSIColor(rlutil::BROWN);
+                    frame += 'T';
+                    frame += rlutil::ANSI_WHITE;
+                }
+                else if (state.apple[cell] || (row == 0 && col == state.bombCol)) {
+                    frame += rlutil::getANSIColor(state.apple[cell] ? rlutil::LIGHTRED : rlutil::CYAN);
+                    frame += 'O';
+                    frame += rlutil::ANSI_WHITE;
+                }
+                else {
+                    frame += state.wall[cell] ? '#' : ' ';
+                }
+            }
+            frame += '\n';
+        }
+
+        for (std::size_t i = 0; i < state.players.size(); i++) {
+            const SyncState::PlayerState &player = state.players[i];
+            frame += "Player " + std::to_string(i + 1) + ": (" + std::to_string(player.row) + ", " +
+                     std::to_string(player.col) + ")" + (player.hasBomb ? ", has a bomb" : "") + '\n';
+        }
+    }
+}
+
+void runInteractiveClient(const Endpoint &endpoint, const int mazeSize) {
+    const int fd = connectTo(endpoint);
+    sendAll(fd, std::to_string(mazeSize) + "\n");
+
+    char buffer[16384];
+    while (true) {
+        pollfd readable{fd, POLLIN, 0};
+        if (poll(&readable, 1, 15) > 0) {
+            const ssize_t count = recv(fd, buffer, sizeof(buffer), 0);
+            if (count <= 0) { // serverul a terminat jocul
+                break;
+            }
+            std::cout.write(buffer, count);
+            std::cout.flush();
+        }
+
+        const int key_pressed = rlutil::nb_getch();
+        if (key_pressed > 0 && !sendAll(fd, std::string(1, (char) key_pressed))) {
+            break;
+        }
+    }
+
+    close(fd);
+}
+
+void runSpectator(const Endpoint &endpoint, const std::uint64_t gameId) {
+    SpectatorStream stream;
+    stream.fd = connectTo(endpoint);
+    sendAll(stream.fd, "watch " + std::to_string(gameId) + "\n");
+
+    std::string frame;
+    std::uint64_t shown = 0;
+    bool open = true;
+    while (open) {
+        pollfd readable{stream.fd, POLLIN, 0};
+        poll(&readable, 1, 1000);
+        open = stream.read();
+
+        if (stream.decoder.hasState() && stream.applied != shown) {
+            shown = stream.applied;
+            renderState(stream.decoder.state(), frame);
+            std::cout << frame;
+            std::cout.flush();
+        }
+    }
+
+    if (!stream.decoder.hasState()) {
+        std::cout << "Session " << gameId << " is not running." << std::endl;
+    }
+    if (stream.decoder.desyncs() > 0) {
+        std::cout << stream.decoder.desyncs() << " messages did not match the server's state hash." << std::endl;
+    }
+    close(stream.fd);
+}
+
+LoadTestResult runLoadTest(const Endpoint &endpoint, const int sessions, const int keysPerSession, const int mazeSize,
+                           const std::uint64_t seed, const int spectatorsPerSession) {
+    constexpr char keys[] = {'w', 'a', 's', 'd', 'f', ' '};
+    LoadTestResult result;
+    result.sessions = sessions;
+    SplitMix64 rng{seed};
+
+    const auto start = std::chrono::steady_clock::now();
+
+    std::vector<int> fds;
+    std::vector<bool> open;
+    for (int i = 0; i < sessions; i++) {
+        const int fd = connectTo(endpoint);
+        fcntl(fd, F_SETFL, fcntl(fd, F_GETFL, 0) | O_NONBLOCK);
+        sendAll(fd, std::to_string(mazeSize) + "\n");
+        fds.push_back(fd);
+        open.push_back(true);
+    }
+
+    // serverul inchide un spectator care cere o sesiune fara joc pornit, asa ca spectatorii se conecteaza abia
+    // dupa ce fiecare jucator a primit primul cadru
+    const auto startDeadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    for (std::size_t i = 0; i < fds.size(); i++) {
+        const auto left = std::chrono::duration_cast<std::chrono::milliseconds>(startDeadline -
+                                                                                std::chrono::steady_clock::now());
+        pollfd readable{fds[i], POLLIN, 0};
+        if (poll(&readable, 1, (int) std::max<std::int64_t>(left.count(), 0)) > 0) {
+            open[i] = drain(fds[i], result.bytesReceived);
+        }
+    }
+
+    std::vector<SpectatorStream> spectators((std::size_t) sessions * std::max(spectatorsPerSession, 0));
+    for (std::size_t i = 0; i < spectators.size(); i++) {
+        spectators[i].fd = connectTo(endpoint);
+        sendAll(spectators[i].fd, "watch " + std::to_string(1 + i % (std::size_t) sessions) + "\n");
+    }
+    std::vector<bool> watching(spectators.size(), true);
+    const auto readSpectators = [&]() {
+        for (std::size_t i = 0; i < spectators.size(); i++) {
+            if (watching[i]) {
+                watching[i] = spectators[i].read();
+            }
+        }
+    };
+
+    // tastele se trimit abia dupa ce fiecare spectator are primul keyframe, altfel desincronizarile nu se masoara
+    const auto waitingForState = [&]() {
+        for (std::size_t i = 0; i < spectators.size(); i++) {
+            if (watching[i] && !spectators[i].decoder.hasState()) {
+                return true;
+            }
+        }
+        return false;
+    };
+    const auto stateDeadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (waitingForState() && std::chrono::steady_clock::now() < stateDeadline) {
+        readSpectators();
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    result.spectators = (int) spectators.size();
+    result.spectatorsStarted = (int) std::count_if(spectators.begin(), spectators.end(),
+                                                   [](const SpectatorStream &spectator) {
+                                                       return spectator.decoder.hasState();
+                                                   });
+
+    for (int round = 0; round <= keysPerSession; round++) {
+        for (std::size_t i = 0; i < fds.size(); i++) {
+            if (!open[i]) {
+                continue;
+            }
+            const char key = round == keysPerSession ? 'q' : keys[rng() % std::size(keys)];
+            if (!sendAll(fds[i], std::string(1, key))) {
+                open[i] = false;
+                continue;
+            }
+            ++result.keysSent;
+            open[i] = drain(fds[i], result.bytesReceived);
+        }
+        readSpectators();
+    }
+
+    // dupa 'q' serverul trimite rezultatul si inchide conexiunea
+    std::vector<pollfd> pending;
+    for (std::size_t i = 0; i < fds.size(); i++) {
+        if (open[i]) {
+            pending.push_back(pollfd{fds[i], POLLIN, 0});
+        }
+    }
+    while (!pending.empty() && poll(pending.data(), pending.size(), 5000) > 0) {
+        for (std::size_t i = 0; i < pending.size();) {
+            if (pending[i].revents != 0 && !drain(pending[i].fd, result.bytesReceived)) {
+                ++result.completed;
+                pending[i] = pending.back();
+                pending.pop_back();
+            }
+            else {
+                pending[i++].revents = 0;
+            }
+        }
+    }
+
+    // spectatorii sunt deconectati de server dupa jucatorul pe care il urmaresc
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (std::find(watching.begin(), watching.end(), true) != watching.end() &&
+           std::chrono::steady_clock::now() < deadline) {
+        readSpectators();
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    for (const int fd: fds) {
+        close(fd);
+    }
+    for (const SpectatorStream &spectator: spectators) {
+        result.spectatorBytes += spectator.bytes;
+        result.spectatorMessages += spectator.applied;
+        result.spectatorDesyncs += spectator.decoder.desyncs();
+        close(spectator.fd);
+    }
+
+    result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return result;
+}
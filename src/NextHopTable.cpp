@@ -0,0 +1,163 @@
+#include "NextHopTable.h"
+
+#include <numeric>
+#include <stdexcept>
+
+namespace {
+    constexpr std::int64_t targetsPerTask = 16; // un BFS pe 900 de celule e prea scurt ca sa fie singur un task
+}
+
+NextHopTable::NextHopTable(const Maze &maze, ThreadPool &pool) {
+    indexCells(maze);
+    if ((int) m_cell.size() > maxCells) {
+        throw std::invalid_argument("maze has too many free cells for an all-pairs next-hop table");
+    }
+    std::vector<std::int32_t> targets(m_cell.size());
+    std::iota(targets.begin(), targets.end(), 0);
+    buildRows(targets, pool);
+}
+
+NextHopTable::NextHopTable(const Maze &maze, const std::vector<std::pair<int, int>> &targets, ThreadPool &pool) {
+    indexCells(maze);
+    std::vector<std::int32_t> rows;
+    std::vector<std::uint8_t> chosen(m_cell.size());
+    for (const auto &[row, col]: targets) {
+        const std::int32_t target = freeIndex(row, col);
+        if (target >= 0 && !chosen[target]) {
+            chosen[target] = 1;
+            rows.push_back(target);
+        }
+    }
+    buildRows(rows, pool);
+}
+
+void NextHopTable::indexCells(const Maze &maze) {
+    m_dim = maze.getSize();
+    m_index.assign((std::size_t) m_dim * m_dim, -1);
+    m_cell.clear();
+    for (int row = 0; row < m_dim; row++) {
+        for (int col = 0; col < m_dim; col++) {
+            if (!maze.isWall(row, col)) {
+                m_index[(std::size_t) row * m_dim + col] = (std::int32_t) m_cell.size();
+                m_cell.push_back(row * m_dim + col);
+            }
+        }
+    }
+    const auto cells = (std::int32_t) m_cell.size();
+    m_neighbours.resize(cells);
+    for (std::int32_t cell = 0; cell < cells; cell++) { // in ordinea din Direction
+        const int row = m_cell[cell] / m_dim, col = m_cell[cell] % m_dim;
+        m_neighbours[cell] = {freeIndex(row - 1, col), freeIndex(row, col - 1), freeIndex(row + 1, col),
+                              freeIndex(row, col + 1)};
+    }
+
+    // componentele conexe: intre doua componente diferite nu exista drum, iar tabela nu are loc pentru asta
+    m_component.assign(cells, -1);
+    std::vector<std::int32_t> queue;
+    queue.reserve(cells);
+    for (std::int32_t start = 0, component = 0; start < cells; start++) {
+        if (m_component[start] >= 0) {
+            continue;
+        }
+        m_component[start] = component;
+        queue.assign(1, start);
+        for (std::size_t head = 0; head < queue.size(); head++) {
+            for (const std::int32_t neighbour: m_neighbours[queue[head]]) {
+                if (neighbour >= 0 && m_component[neighbour] < 0) {
+                    m_component[neighbour] = component;
+                    queue.push_back(neighbour);
+                }
+            }
+        }
+        ++component;
+    }
+}
+
+void NextHopTable::buildRows(const std::vector<std::int32_t> &targets, ThreadPool &pool) {
+    m_rowOf.assign(m_cell.size(), -1);
+    for (std::size_t slot = 0; slot < targets.size(); slot++) {
+        m_rowOf[targets[slot]] = (std::int32_t) slot;
+    }
+
+    m_rowBytes = (m_cell.size() + 3) / 4;
+    m_table.assign(m_rowBytes * targets.size(), 0);
+    pool.parallelFor(0, (std::int64_t) targets.size(), targetsPerTask, [&](const std::int64_t begin, const std::int64_t end) {
+        std::vector<std::int32_t> rowQueue;
+        std::vector<std::uint8_t> seen;
+        for (std::int64_t slot = begin; slot < end; slot++) {
+            buildRow((std::size_t) slot, targets[slot], rowQueue, seen);
+        }
+    });
+}
+
+void NextHopTable::buildRow(const std::size_t slot, const std::int32_t target, std::vector<std::int32_t> &queue,
+                            std::vector<std::uint8_t> &seen) {
+    // BFS din tinta: o celula descoperita din vecinul u are ca prim pas directia spre u
+    std::uint8_t *const row = m_table.data() + slot * m_rowBytes;
+    seen.assign(m_cell.size(), 0);
+    seen[target] = 1;
+    queue.assign(1, target);
+    for (std::size_t head = 0; head < queue.size(); head++) {
+        const std::array<std::int32_t, 4> &neighbours = m_neighbours[queue[head]];
+        for (int direction = 0; direction < 4; direction++) {
+            const std::int32_t neighbour = neighbours[direction];
+            if (neighbour >= 0 && !seen[neighbour]) {
+                // vecinul de sus ajunge aici cu un pas in jos, cel din stanga cu un pas la dreapta etc.
+                const int back = (direction + 2) % 4;
+                seen[neighbour] = 1;
+                row[neighbour / 4] = (std::uint8_t) (row[neighbour / 4] | back << 2 * (neighbour % 4));
+                queue.push_back(neighbour);
+            }
+        }
+    }
+}
+
+std::int32_t NextHopTable::freeIndex(const int row, const int col) const {
+    if (row < 0 || col < 0 || row >= m_dim || col >= m_dim) {
+        return -1;
+    }
+    return m_index[(std::size_t) row * m_dim + col];
+}
+
+NextHopTable::Direction NextHopTable::direction(const int fromRow, const int fromCol, const int toRow,
+                                                const int toCol) const {
+    const std::int32_t from = freeIndex(fromRow, fromCol), to = freeIndex(toRow, toCol);
+    if (from < 0 || to < 0 || from == to || m_component[from] != m_component[to] || m_rowOf[to] < 0) {
+        return Direction::None;
+    }
+    return (Direction) (m_table[(std::size_t) m_rowOf[to] * m_rowBytes + from / 4] >> 2 * (from % 4) & 3);
+}
+
+std::pair<int, int> NextHopTable::nextStep(const int fromRow, const int fromCol, const int toRow,
+                                           const int toCol) const {
+    switch (direction(fromRow, fromCol, toRow, toCol)) {
+        case Direction::Up:
+            return {fromRow - 1, fromCol};
+        case Direction::Left:
+            return {fromRow, fromCol - 1};
+        case Direction::Down:
+            return {fromRow + 1, fromCol};
+        case Direction::Right:
+            return {fromRow, fromCol + 1};
+        default:
+            return {fromRow, fromCol};
+    }
+}
+
+bool NextHopTable::isReachable(const int fromRow, const int fromCol, const int toRow, const int toCol) const {
+    const std::int32_t from = freeIndex(fromRow, fromCol), to = freeIndex(toRow, toCol);
+    return from >= 0 && to >= 0 && m_component[from] == m_component[to];
+}
+
+char NextHopTable::key(const Direction direction) {
+    constexpr char keys[] = {'w', 'a', 's', 'd', 0};
+    return keys[(int) direction];
+}
+
+int NextHopTable::freeCells() const {
+    return (int) m_cell.size();
+}
+
+std::size_t NextHopTable::tableBytes() const {
+    return m_table.size();
+}
@@ -0,0 +1,31 @@
+#include "Object.h"
+
+Object::~Object() {
+    std::cout<<"Destr Object"<<std::endl;
+}
+
+Object &Object::operator=(const Object &obj) { // NOLINT(*-use-equals-default)
+    // suppress-ul este pentru ca op= ar trebui declarat cu = default
+
+    this->m_crtCol = obj.m_crtCol;
+    this->m_crtRow = obj.m_crtRow;
+    this->m_color = obj.m_color;
+
+    return *this;
+}
+
+std::ostream &operator<<(std::ostream &out, const Object &object) {
+    rlutil::setColor(object.m_color);
+    gotoxy(object.m_crtCol + 1, object.m_crtRow + 1);
+    out << 'O';
+    rlutil::setColor(rlutil::WHITE);
+    return out;
+}
+
+std::pair<int, int> Object::getPosition() const {
+    return std::make_pair(m_crtRow, m_crtCol);
+}
+
+int Object::getColor() const {
+    return m_color;
+}
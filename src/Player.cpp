@@ -0,0 +1,41 @@
+#include "Player.h"
+
+#include <rlutil.h>
+
+Player::~Player() {
+    std::cout<<"Destr Player"<<std::endl;
+}
+
+[[maybe_unused]] Player::Player(const Player &player) {
+    this->m_crtRow = player.m_crtRow;
+    this->m_crtCol = player.m_crtCol;
+    this->m_hasBomb = player.m_hasBomb;
+}
+
+Player &Player::operator=(const std::pair<int, int> pos) {
+    m_crtRow = pos.first;
+    m_crtCol = pos.second;
+    return *this;
+}
+
+std::ostream& operator<<(std::ostream &out, const Player &player) {
+    rlutil::setColor(rlutil::BROWN);
+
+    gotoxy(player.m_crtCol + 1, player.m_crtRow + 1);
+    out << 'T';
+    rlutil::setColor(rlutil::WHITE);
+
+    return out;
+}
+
+void Player::setHasBomb(const bool val) {
+    m_hasBomb = val;
+}
+
+bool Player::getHasBomb() const {
+    return m_hasBomb;
+}
+
+std::pair<int, int> Player::getPosition() const {
+    return std::pair<int, int>{m_crtRow, m_crtCol};
+}
@@ -0,0 +1,50 @@
+#include "PnmExport.h"
+
+#include <stdexcept>
+#include <string>
+
+PnmWriter::PnmWriter(std::ostream &out, const int width, const int height, const Format format)
+        : m_out(out), m_width(width), m_rowsLeft(height), m_format(format),
+          m_row(format == Format::Bitmap ? ((std::size_t) width + 7) / 8 : (std::size_t) width) {
+    if (width < 1 || height < 1) {
+        throw std::invalid_argument("empty image");
+    }
+    m_out << (format == Format::Bitmap ? "P4\n" : "P5\n") << width << ' ' << height << '\n';
+    if (format == Format::Graymap) {
+        m_out << "255\n";
+    }
+}
+
+void PnmWriter::writeRow(const std::uint8_t *pixels) {
+    if (m_rowsLeft == 0) {
+        throw std::logic_error("image already has all its rows");
+    }
+    if (m_format == Format::Bitmap) { // primul pixel in bitul cel mai semnificativ
+        std::fill(m_row.begin(), m_row.end(), 0);
+        for (int col = 0; col < m_width; col++) {
+            if (pixels[col]) {
+                m_row[col / 8] = (char) (m_row[col / 8] | 0x80 >> (col % 8));
+            }
+        }
+    }
+    else {
+        std::copy(pixels, pixels + m_width, m_row.begin());
+    }
+    m_out.write(m_row.data(), (std::streamsize) m_row.size());
+    if (!m_out) {
+        throw std::runtime_error("cannot write image row");
+    }
+    --m_rowsLeft;
+}
+
+int PnmWriter::rowsLeft() const {
+    return m_rowsLeft;
+}
+
+std::uint8_t Heatmap::shade(const std::uint64_t distance, const std::uint64_t maxDistance) {
+    constexpr std::uint64_t nearest = 255, farthest = 48;
+    if (maxDistance == 0) {
+        return (std::uint8_t) nearest;
+    }
+    return (std::uint8_t) (nearest - (nearest - farthest) * std::min(distance, maxDistance) / maxDistance);
+}
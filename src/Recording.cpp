@@ -0,0 +1,111 @@
+#include "Recording.h"
+
+#include <algorithm>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+
+#include "Varint.h"
+
+void Recording::addEvent(const std::uint64_t timeMs, const char key) {
+    m_events.push_back(Event{timeMs, key});
+}
+
+void Recording::setEndTime(const std::uint64_t timeMs) {
+    m_endTimeMs = timeMs;
+}
+
+void Recording::setTimeLimit(const std::chrono::seconds timeLimit) {
+    m_timeLimit = timeLimit;
+}
+
+// format: "NITM" | versiune | varint seed | varint dimensiune | varint timp acordat in s (de la versiunea 2) |
+//         varint nr. evenimente |
+//         (varint delta ms fata de evenimentul anterior, octet tasta)* | varint delta ms pana la final
+void Recording::save(const std::string &path) const {
+    std::vector<std::uint8_t> data(std::begin(magic), std::end(magic));
+    data.push_back(version);
+    writeVarint(data, m_seed);
+    writeVarint(data, (std::uint64_t) m_mazeSize);
+    writeVarint(data, (std::uint64_t) m_timeLimit.count());
+    writeVarint(data, m_events.size());
+
+    std::uint64_t previous = 0;
+    for (const Event &event: m_events) {
+        writeVarint(data, event.timeMs - previous);
+        data.push_back((std::uint8_t) event.key);
+        previous = event.timeMs;
+    }
+    writeVarint(data, m_endTimeMs - previous);
+
+    std::ofstream file(path, std::ios::binary);
+    if (!file) {
+        throw std::runtime_error("cannot write recording to " + path);
+    }
+    file.write(reinterpret_cast<const char *>(data.data()), (std::streamsize) data.size());
+}
+
+Recording Recording::load(const std::string &path) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        throw std::runtime_error("cannot open recording " + path);
+    }
+    const std::vector<std::uint8_t> data{std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()};
+
+    if (data.size() < sizeof(magic) + 1 || !std::equal(std::begin(magic), std::end(magic), data.begin()) ||
+        data[sizeof(magic)] < 1 || data[sizeof(magic)] > version) {
+        throw std::runtime_error(path + " is not a recording");
+    }
+
+    std::size_t pos = sizeof(magic) + 1;
+    std::uint64_t seed = 0, mazeSize = 0, timeLimit = 0, count = 0;
+    if (!readVarint(data, pos, seed) || !readVarint(data, pos, mazeSize) ||
+        (data[sizeof(magic)] >= 2 && !readVarint(data, pos, timeLimit)) || !readVarint(data, pos, count)) {
+        throw std::runtime_error(path + " has a truncated header");
+    }
+    // un fisier stricat nu trebuie sa ajunga la Game cu o dimensiune pe care jocul nu o poate genera
+    if (mazeSize < minMazeSize || mazeSize > maxMazeSize) {
+        throw std::runtime_error(path + " has an unsupported maze size " + std::to_string(mazeSize));
+    }
+
+    Recording recording{(std::uint32_t) seed, (int) mazeSize};
+    recording.setTimeLimit(std::chrono::seconds((long long) timeLimit));
+    std::uint64_t time = 0;
+    for (std::uint64_t i = 0; i < count; i++) {
+        std::uint64_t delta = 0;
+        if (!readVarint(data, pos, delta) || pos >= data.size()) {
+            throw std::runtime_error(path + " has a truncated event stream");
+        }
+        time += delta;
+        recording.addEvent(time, (char) data[pos++]);
+    }
+
+    std::uint64_t endDelta = 0;
+    if (!readVarint(data, pos, endDelta)) {
+        throw std::runtime_error(path + " has no end marker");
+    }
+    recording.setEndTime(time + endDelta);
+
+    return recording;
+}
+
+std::uint32_t Recording::getSeed() const {
+    return m_seed;
+}
+
+int Recording::getMazeSize() const {
+    return m_mazeSize;
+}
+
+const std::vector<Recording::Event> &Recording::getEvents() const {
+    return m_events;
+}
+
+std::uint64_t Recording::getEndTime() const {
+    return m_endTimeMs;
+}
+
+std::chrono::seconds Recording::getTimeLimit() const {
+    return m_timeLimit;
+}
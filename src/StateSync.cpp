@@ -0,0 +1,329 @@
+#include "StateSync.h"
+
+#include <limits>
+#include <utility>
+
+#include "Varint.h"
+#include "Zobrist.h"
+
+namespace {
+    constexpr std::uint8_t keyframeKind = 0;
+    constexpr std::uint8_t deltaKind = 1;
+
+    // octetul de cod al unui jucator din delta
+    constexpr std::uint8_t stepMask = 0x07; // 0 pe loc, 1-4 un pas w/a/s/d, absolutePosition = urmeaza randul si coloana
+    constexpr std::uint8_t absolutePosition = 0x07;
+    constexpr std::uint8_t hasBombBit = 0x08;
+    constexpr std::uint8_t scoreBit = 0x10; // urmeaza scorul nou
+
+    constexpr int stepRow[] = {0, -1, 0, 1, 0};
+    constexpr int stepCol[] = {0, 0, -1, 0, 1};
+
+    // limite pentru datele venite din retea, ca un mesaj corupt sa nu ceara alocari uriase
+    constexpr std::uint64_t maxDim = 4096;
+    constexpr std::uint64_t maxPlayers = 1 << 16;
+
+    void writeChangedCells(std::vector<std::uint8_t> &out, const std::vector<std::uint8_t> &before,
+                           const std::vector<std::uint8_t> &after) {
+        std::uint64_t count = 0;
+        for (std::size_t i = 0; i < after.size(); i++) {
+            count += before[i] != after[i];
+        }
+        writeVarint(out, count);
+
+        std::size_t last = 0;
+        for (std::size_t i = 0; i < after.size(); i++) {
+            if (before[i] != after[i]) {
+                writeVarint(out, i - last); // indecsi crescatori, deci diferentele sunt mici
+                last = i;
+            }
+        }
+    }
+
+    void writeHash(std::vector<std::uint8_t> &out, const std::uint64_t hash) { // fix 8 octeti: un varint ar avea 10
+        for (int byte = 0; byte < 8; byte++) {
+            out.push_back((std::uint8_t) (hash >> 8 * byte));
+        }
+    }
+
+    bool readHash(const std::vector<std::uint8_t> &in, std::size_t &pos, std::uint64_t &hash) {
+        if (in.size() - pos < 8) {
+            return false;
+        }
+        hash = 0;
+        for (int byte = 0; byte < 8; byte++) {
+            hash |= (std::uint64_t) in[pos++] << 8 * byte;
+        }
+        return true;
+    }
+
+    // celulele schimbate se aplica prin XOR, deci si hash-ul starii se actualizeaza cu cheile lor
+    bool readChangedCells(const std::vector<std::uint8_t> &in, std::size_t &pos, std::vector<std::uint8_t> &cells,
+                          const Zobrist::Feature feature, std::uint64_t &hash) {
+        std::uint64_t count = 0;
+        if (!readVarint(in, pos, count) || count > cells.size()) {
+            return false;
+        }
+
+        std::uint64_t index = 0;
+        for (std::uint64_t i = 0; i < count; i++) {
+            std::uint64_t gap = 0;
+            if (!readVarint(in, pos, gap) || gap >= cells.size() - index) {
+                return false;
+            }
+            index += gap;
+            cells[index] ^= 1;
+            hash ^= Zobrist::key(feature, index);
+        }
+        return true;
+    }
+
+    bool readInt(const std::vector<std::uint8_t> &in, std::size_t &pos, const std::uint64_t limit, int &value) {
+        std::uint64_t raw = 0;
+        if (!readVarint(in, pos, raw) || raw > limit) {
+            return false;
+        }
+        value = (int) raw;
+        return true;
+    }
+}
+
+DeltaEncoder::DeltaEncoder(const int keyframeInterval) : m_keyframeInterval(keyframeInterval) {}
+
+bool DeltaEncoder::encode(const SyncState &state, std::vector<std::uint8_t> &out) {
+    const bool keyframe = m_forceKeyframe || m_sinceKeyframe >= m_keyframeInterval ||
+                          state.dim != m_previous.dim || state.players.size() != m_previous.players.size();
+    if (!keyframe && state == m_previous) {
+        return false;
+    }
+
+    ++m_sequence;
+    m_lastWasKeyframe = keyframe;
+    if (keyframe) {
+        writeKeyframe(state, out);
+        m_sinceKeyframe = 0;
+        m_forceKeyframe = false;
+    }
+    else {
+        writeDelta(state, out);
+        ++m_sinceKeyframe;
+    }
+
+    m_previous = state;
+    return true;
+}
+
+void DeltaEncoder::writeKeyframe(const SyncState &state, std::vector<std::uint8_t> &out) const {
+    out.push_back(keyframeKind);
+    writeVarint(out, m_sequence);
+    writeHash(out, state.hash);
+    writeVarint(out, (std::uint64_t) state.dim);
+    writeVarint(out, state.players.size());
+    writeBitset(out, state.wall);
+    writeBitset(out, state.apple);
+    writeVarint(out, (std::uint64_t) (state.bombCol + 1));
+
+    for (const SyncState::PlayerState &player: state.players) {
+        writeVarint(out, (std::uint64_t) player.row);
+        writeVarint(out, (std::uint64_t) player.col);
+        writeVarint(out, ((std::uint64_t) player.score << 1) | (player.hasBomb ? 1 : 0));
+    }
+}
+
+void DeltaEncoder::writeDelta(const SyncState &state, std::vector<std::uint8_t> &out) const {
+    out.push_back(deltaKind);
+    writeVarint(out, m_sequence);
+    writeHash(out, state.hash);
+    writeChangedCells(out, m_previous.wall, state.wall);
+    writeChangedCells(out, m_previous.apple, state.apple);
+    writeVarint(out, (std::uint64_t) (state.bombCol + 1));
+
+    std::uint64_t changed = 0;
+    for (std::size_t i = 0; i < state.players.size(); i++) {
+        changed += state.players[i] != m_previous.players[i];
+    }
+    writeVarint(out, changed);
+
+    std::size_t last = 0;
+    for (std::size_t i = 0; i < state.players.size(); i++) {
+        const SyncState::PlayerState &before = m_previous.players[i];
+        const SyncState::PlayerState &after = state.players[i];
+        if (after == before) {
+            continue;
+        }
+
+        std::uint8_t code = absolutePosition;
+        for (std::uint8_t step = 0; step < 5; step++) { // de obicei jucatorul a facut cel mult un pas
+            if (after.row == before.row + stepRow[step] && after.col == before.col + stepCol[step]) {
+                code = step;
+                break;
+            }
+        }
+        if (after.hasBomb) {
+            code |= hasBombBit;
+        }
+        if (after.score != before.score) {
+            code |= scoreBit;
+        }
+
+        writeVarint(out, i - last);
+        last = i;
+        out.push_back(code);
+        if ((code & stepMask) == absolutePosition) {
+            writeVarint(out, (std::uint64_t) after.row);
+            writeVarint(out, (std::uint64_t) after.col);
+        }
+        if (code & scoreBit) {
+            writeVarint(out, (std::uint64_t) after.score);
+        }
+    }
+}
+
+void DeltaEncoder::requestKeyframe() {
+    m_forceKeyframe = true;
+}
+
+std::uint64_t DeltaEncoder::sequence() const {
+    return m_sequence;
+}
+
+bool DeltaEncoder::lastWasKeyframe() const {
+    return m_lastWasKeyframe;
+}
+
+bool DeltaDecoder::apply(const std::vector<std::uint8_t> &message) {
+    std::size_t pos = 1; // dupa octetul cu tipul mesajului
+    std::uint64_t sequence = 0, hash = 0;
+    if (message.empty() || !readVarint(message, pos, sequence) || !readHash(message, pos, hash)) {
+        return false;
+    }
+    const std::uint8_t kind = message[0];
+
+    SyncState next; // se lucreaza pe o copie, ca un mesaj invalid sa nu strice starea
+    if (kind == keyframeKind) {
+        int players = 0;
+        if (!readInt(message, pos, maxDim, next.dim) || !readInt(message, pos, maxPlayers, players) ||
+            (next.dim == 0 && players > 0)) {
+            return false;
+        }
+        next.wall.resize((std::size_t) next.dim * next.dim);
+        next.apple.resize((std::size_t) next.dim * next.dim);
+        next.players.resize(players);
+        if (!readBitset(message, pos, next.wall) || !readBitset(message, pos, next.apple)) {
+            return false;
+        }
+    }
+    else if (kind == deltaKind) {
+        if (!m_hasState || sequence != m_sequence + 1) {
+            return false;
+        }
+        next = m_state;
+        if (!readChangedCells(message, pos, next.wall, Zobrist::Feature::Wall, next.hash) ||
+            !readChangedCells(message, pos, next.apple, Zobrist::Feature::Apple, next.hash)) {
+            return false;
+        }
+    }
+    else {
+        return false;
+    }
+
+    int bombCol = 0;
+    if (!readInt(message, pos, (std::uint64_t) next.dim, bombCol)) {
+        return false;
+    }
+    if (kind == deltaKind && next.bombCol != bombCol - 1) {
+        next.hash ^= (next.bombCol >= 0 ? Zobrist::bomb(next.bombCol) : 0) ^ (bombCol > 0 ? Zobrist::bomb(bombCol - 1) : 0);
+    }
+    next.bombCol = bombCol - 1;
+
+    // pozitiile jucatorilor indexeaza grila la afisare, deci trebuie sa ramana in [0, dim)
+    const auto lastCell = (std::uint64_t) (next.dim - 1);
+    if (kind == keyframeKind) {
+        for (SyncState::PlayerState &player: next.players) {
+            std::uint64_t scoreAndBomb = 0;
+            if (!readInt(message, pos, lastCell, player.row) || !readInt(message, pos, lastCell, player.col) ||
+                !readVarint(message, pos, scoreAndBomb)) {
+                return false;
+            }
+            player.hasBomb = scoreAndBomb & 1;
+            player.score = (int) (scoreAndBomb >> 1);
+        }
+    }
+    else {
+        std::uint64_t changed = 0;
+        if (!readVarint(message, pos, changed) || changed > next.players.size()) {
+            return false;
+        }
+
+        std::uint64_t index = 0;
+        for (std::uint64_t i = 0; i < changed; i++) {
+            std::uint64_t gap = 0;
+            if (!readVarint(message, pos, gap) || gap >= next.players.size() - index || pos >= message.size()) {
+                return false;
+            }
+            index += gap;
+
+            SyncState::PlayerState &player = next.players[index];
+            next.hash ^= Zobrist::player((int) index, next.dim, player.row, player.col) ^
+                         (player.hasBomb ? Zobrist::hasBomb((int) index) : 0);
+            const std::uint8_t code = message[pos++];
+            const std::uint8_t step = code & stepMask;
+            if (step == absolutePosition) {
+                if (!readInt(message, pos, lastCell, player.row) || !readInt(message, pos, lastCell, player.col)) {
+                    return false;
+                }
+            }
+            else if (step < 5) {
+                player.row += stepRow[step];
+                player.col += stepCol[step];
+                if (player.row < 0 || player.col < 0 || player.row >= next.dim || player.col >= next.dim) {
+                    ++m_desyncs; // un pas in afara labirintului: starea de baza nu mai este cea a serverului
+                    return false;
+                }
+            }
+            else {
+                return false;
+            }
+
+            player.hasBomb = code & hasBombBit;
+            if ((code & scoreBit) && !readInt(message, pos, (std::uint64_t) std::numeric_limits<int>::max(), player.score)) {
+                return false;
+            }
+            next.hash ^= Zobrist::player((int) index, next.dim, player.row, player.col) ^
+                         (player.hasBomb ? Zobrist::hasBomb((int) index) : 0);
+        }
+    }
+
+    if (pos != message.size()) {
+        return false;
+    }
+    // un delta isi actualizeaza hash-ul cu XOR-ul cheilor schimbate; un keyframe il calculeaza din toata starea
+    if (kind == keyframeKind) {
+        next.hash = Zobrist::hash(next);
+    }
+    if (next.hash != hash) {
+        ++m_desyncs;
+        return false;
+    }
+
+    m_state = std::move(next);
+    m_sequence = sequence;
+    m_hasState = true;
+    return true;
+}
+
+bool DeltaDecoder::hasState() const {
+    return m_hasState;
+}
+
+const SyncState &DeltaDecoder::state() const {
+    return m_state;
+}
+
+std::uint64_t DeltaDecoder::sequence() const {
+    return m_sequence;
+}
+
+std::uint64_t DeltaDecoder::desyncs() const {
+    return m_desyncs;
+}
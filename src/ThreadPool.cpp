@@ -0,0 +1,193 @@
+#include "ThreadPool.h"
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace {
+    thread_local const ThreadPool *t_pool = nullptr; // pool-ul caruia ii apartine thread-ul curent
+    thread_local unsigned t_index = 0; // indexul workerului in acel pool
+
+    ThreadPool::Config &sharedConfig() {
+        static ThreadPool::Config config;
+        return config;
+    }
+
+    void pinCurrentThread([[maybe_unused]] const int cpu) {
+#if defined(__linux__)
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        CPU_SET(cpu, &set);
+        pthread_setaffinity_np(pthread_self(), sizeof(set), &set); // daca nu reuseste, thread-ul ramane nefixat
+#endif
+    }
+
+    // SCHED_IDLE: thread-ul ruleaza doar cand procesorul nu are altceva de facut, deci nu intrerupe jocul
+    void lowerCurrentThreadPriority() {
+#if defined(__linux__)
+        sched_param param{};
+        pthread_setschedparam(pthread_self(), SCHED_IDLE, &param); // daca nu reuseste, prioritatea ramane normala
+#endif
+    }
+}
+
+ThreadPool::ThreadPool() : ThreadPool(Config{}) {}
+
+ThreadPool::ThreadPool(Config config) {
+    for (unsigned i = 0; i < config.threads; i++) {
+        m_queues.push_back(std::make_unique<Worker>());
+    }
+    for (unsigned i = 0; i < config.threads; i++) {
+        const int cpu = config.cpus.empty() ? (int) i : config.cpus[i % config.cpus.size()];
+        m_threads.emplace_back([this, i, cpu, pin = config.pinThreads, background = config.background]() {
+            if (pin) {
+                pinCurrentThread(cpu);
+            }
+            if (background) {
+                lowerCurrentThreadPriority();
+            }
+            workerLoop(i);
+        });
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        const std::lock_guard<std::mutex> lock(m_sleepMutex);
+        m_stop = true;
+    }
+    m_wake.notify_all();
+    for (std::thread &thread: m_threads) {
+        thread.join();
+    }
+}
+
+ThreadPool &ThreadPool::shared() {
+    static ThreadPool pool{sharedConfig()};
+    return pool;
+}
+
+void ThreadPool::configureShared(Config config) {
+    sharedConfig() = std::move(config);
+}
+
+void ThreadPool::submit(std::function<void()> task) {
+    const auto run = [](const void *context, std::int64_t, std::int64_t) {
+        const std::unique_ptr<const std::function<void()>> function{static_cast<const std::function<void()> *>(context)};
+        (*function)();
+    };
+
+    if (m_queues.empty()) { // fara workeri task-ul ruleaza imediat
+        task();
+        return;
+    }
+
+    const Task wrapped{run, new std::function<void()>(std::move(task)), 0, 0, nullptr};
+    push(&wrapped, 1);
+}
+
+void ThreadPool::push(const Task *tasks, const std::size_t count) {
+    m_pending.fetch_add((std::int64_t) count);
+
+    if (t_pool == this) { // din interiorul pool-ului: in coada proprie, ceilalti vor fura daca sunt liberi
+        Worker &own = *m_queues[t_index];
+        const std::lock_guard<std::mutex> lock(own.mutex);
+        own.tasks.insert(own.tasks.end(), tasks, tasks + count);
+    }
+    else { // din afara: impart task-urile intre cozi
+        for (std::size_t i = 0; i < count; i++) {
+            Worker &queue = *m_queues[m_nextQueue.fetch_add(1) % m_queues.size()];
+            const std::lock_guard<std::mutex> lock(queue.mutex);
+            queue.tasks.push_back(tasks[i]);
+        }
+    }
+
+    {
+        // un worker care tocmai a vazut m_pending == 0 si urmeaza sa doarma nu poate rata notificarea
+        const std::lock_guard<std::mutex> lock(m_sleepMutex);
+    }
+    if (count == 1) {
+        m_wake.notify_one();
+    }
+    else {
+        m_wake.notify_all();
+    }
+}
+
+bool ThreadPool::popOrSteal(Task &task) {
+    const bool inPool = t_pool == this;
+    const std::size_t queues = m_queues.size();
+    const std::size_t self = inPool ? t_index : m_nextQueue.load() % queues;
+
+    if (inPool) {
+        Worker &own = *m_queues[self];
+        const std::lock_guard<std::mutex> lock(own.mutex);
+        if (!own.tasks.empty()) {
+            task = own.tasks.back();
+            own.tasks.pop_back();
+            return true;
+        }
+    }
+
+    for (std::size_t offset = inPool ? 1 : 0; offset < queues; offset++) {
+        Worker &victim = *m_queues[(self + offset) % queues];
+        const std::lock_guard<std::mutex> lock(victim.mutex);
+        if (!victim.tasks.empty()) {
+            task = victim.tasks.front();
+            victim.tasks.pop_front();
+            return true;
+        }
+    }
+    return false;
+}
+
+bool ThreadPool::tryRunOne() {
+    Task task{};
+    if (!popOrSteal(task)) {
+        return false;
+    }
+    m_pending.fetch_sub(1);
+    execute(task);
+    return true;
+}
+
+void ThreadPool::execute(const Task &task) noexcept {
+    task.run(task.context, task.begin, task.end);
+    if (task.remaining != nullptr) {
+        task.remaining->fetch_sub(1, std::memory_order_release);
+    }
+}
+
+void ThreadPool::waitFor(const std::atomic<std::int64_t> &remaining) {
+    while (remaining.load(std::memory_order_acquire) > 0) {
+        if (!tryRunOne()) { // bucatile ramase ruleaza deja pe alti workeri
+            std::this_thread::yield();
+        }
+    }
+}
+
+void ThreadPool::workerLoop(const unsigned index) {
+    t_pool = this;
+    t_index = index;
+
+    while (true) {
+        if (tryRunOne()) {
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(m_sleepMutex);
+        m_wake.wait(lock, [this]() { return m_stop || m_pending.load() > 0; });
+        if (m_stop && m_pending.load() <= 0) {
+            return;
+        }
+    }
+}
+
+unsigned ThreadPool::workerCount() const {
+    return (unsigned) m_threads.size();
+}
+
+unsigned ThreadPool::concurrency() const {
+    return workerCount() + 1;
+}
@@ -0,0 +1,82 @@
+#include "TimerWheel.h"
+
+#include <algorithm>
+
+TimerWheel::TimerWheel(const Clock::time_point origin, const Clock::duration resolution, const std::size_t slots)
+        : m_slots(slots), m_resolution(resolution), m_origin(origin), m_now(origin) {}
+
+std::size_t TimerWheel::schedule(const Clock::duration delay, Callback callback) {
+    const Clock::duration untilDeadline = m_now + delay - m_origin;
+    // rotunjesc in sus ca un timer sa nu expire niciodata mai devreme decat a fost cerut
+    std::uint64_t target = (std::uint64_t) ((untilDeadline + m_resolution - Clock::duration{1}) / m_resolution);
+    if (target < m_tick) {
+        target = m_tick;
+    }
+
+    const std::size_t slot = target % m_slots.size();
+    const std::size_t id = m_nextId++;
+    m_slots[slot].push_back(Timer{id, (target - m_tick) / m_slots.size(), std::move(callback)});
+    m_slotOf[id] = slot;
+    return id;
+}
+
+void TimerWheel::cancel(const std::size_t id) {
+    const auto it = m_slotOf.find(id);
+    if (it == m_slotOf.end()) {
+        return;
+    }
+    std::erase_if(m_slots[it->second], [id](const Timer &timer) { return timer.id == id; });
+    m_slotOf.erase(it);
+}
+
+void TimerWheel::advance(const Clock::time_point now) {
+    m_now = now;
+    std::vector<Timer> due;
+
+    while (tickTime(m_tick) <= now) {
+        if (m_slotOf.empty()) { // nu am ce procesa, sar direct la tick-ul curent
+            m_tick = (std::uint64_t) ((now - m_origin) / m_resolution) + 1;
+            break;
+        }
+
+        std::vector<Timer> &slot = m_slots[m_tick % m_slots.size()];
+        ++m_tick; // timerele programate din callback-uri ajung in tick-urile urmatoare
+
+        for (auto it = slot.begin(); it != slot.end();) {
+            if (it->rounds == 0) {
+                m_slotOf.erase(it->id);
+                due.push_back(std::move(*it));
+                it = slot.erase(it);
+            }
+            else {
+                --it->rounds;
+                ++it;
+            }
+        }
+
+        for (Timer &timer: due) {
+            timer.callback();
+        }
+        due.clear();
+    }
+}
+
+TimerWheel::Clock::time_point TimerWheel::nextExpiry() const {
+    // caut primul slot nevid in cel mult o rotatie; mai departe de atat e suficient sa ma trezesc o data pe rotatie
+    for (std::uint64_t tick = m_tick; tick < m_tick + m_slots.size(); tick++) {
+        for (const Timer &timer: m_slots[tick % m_slots.size()]) {
+            if (timer.rounds == 0) {
+                return tickTime(tick);
+            }
+        }
+    }
+    return tickTime(m_tick + m_slots.size());
+}
+
+bool TimerWheel::empty() const {
+    return m_slotOf.empty();
+}
+
+TimerWheel::Clock::time_point TimerWheel::tickTime(const std::uint64_t tick) const {
+    return m_origin + m_resolution * (Clock::rep) tick;
+}
@@ -0,0 +1,46 @@
+#include "Varint.h"
+
+void writeVarint(std::vector<std::uint8_t> &out, std::uint64_t value) {
+    while (value >= 0x80) {
+        out.push_back((std::uint8_t) (value | 0x80));
+        value >>= 7;
+    }
+    out.push_back((std::uint8_t) value);
+}
+
+bool readVarint(const std::vector<std::uint8_t> &in, std::size_t &pos, std::uint64_t &value) {
+    value = 0;
+    for (int shift = 0; pos < in.size() && shift < 64; shift += 7) {
+        const std::uint8_t byte = in[pos++];
+        value |= (std::uint64_t) (byte & 0x7F) << shift;
+        if ((byte & 0x80) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void writeBitset(std::vector<std::uint8_t> &out, const std::vector<std::uint8_t> &cells) {
+    std::uint8_t byte = 0;
+    for (std::size_t i = 0; i < cells.size(); i++) {
+        byte |= (std::uint8_t) ((cells[i] ? 1 : 0) << (i % 8));
+        if (i % 8 == 7) {
+            out.push_back(byte);
+            byte = 0;
+        }
+    }
+    if (cells.size() % 8) {
+        out.push_back(byte);
+    }
+}
+
+bool readBitset(const std::vector<std::uint8_t> &in, std::size_t &pos, std::vector<std::uint8_t> &cells) {
+    if (pos > in.size() || in.size() - pos < (cells.size() + 7) / 8) {
+        return false;
+    }
+    for (std::size_t i = 0; i < cells.size(); i++) {
+        cells[i] = (std::uint8_t) ((in[pos + i / 8] >> (i % 8)) & 1);
+    }
+    pos += (cells.size() + 7) / 8;
+    return true;
+}
@@ -0,0 +1,199 @@
+#include "VectorEnv.h"
+
+#include <algorithm>
+#include <random>
+#include <stdexcept>
+
+#include "Sidewinder.h"
+#include "ThreadPool.h"
+
+namespace {
+    constexpr int envsPerTask = 512; // destul de mare ca sa acopere costul unui task, destul de mic pentru stealing
+}
+
+VectorEnv::VectorEnv(const int numEnvs, const int mazeSize, const std::uint64_t seed, const int maxSteps,
+                     const int bombRespawnSteps)
+        : m_numEnvs(numEnvs), m_dim(mazeSize), m_cellsPerEnv(mazeSize * mazeSize),
+          m_maxSteps(maxSteps > 0 ? maxSteps : 4 * mazeSize * mazeSize), m_bombRespawnSteps(bombRespawnSteps),
+          m_wall((std::size_t) numEnvs * m_cellsPerEnv), m_apple((std::size_t) numEnvs * m_cellsPerEnv),
+          m_row(numEnvs), m_col(numEnvs), m_applesLeft(numEnvs), m_hasBomb(numEnvs), m_bombCol(numEnvs),
+          m_bombRespawnIn(numEnvs), m_steps(numEnvs), m_walls(numEnvs), m_reward(numEnvs), m_done(numEnvs) {
+    if (numEnvs < 1 || mazeSize < 4) {
+        throw std::invalid_argument("VectorEnv needs at least one environment and a maze size of at least 4");
+    }
+
+    m_rng.reserve(numEnvs);
+    for (int env = 0; env < numEnvs; env++) { // seed-uri diferite, derivate determinist din seed-ul comun
+        m_rng.emplace_back(seed ^ ((std::uint64_t) env * 0xD1B54A32D192ED03ULL));
+        reset(env);
+    }
+}
+
+int VectorEnv::randInt(const int env, const int from, const int to) {
+    return std::uniform_int_distribution<int>{from, to}(m_rng[env]);
+}
+
+std::size_t VectorEnv::cellIndex(const int env, const int row, const int col) const {
+    return (std::size_t) env * m_cellsPerEnv + (std::size_t) row * m_dim + col;
+}
+
+void VectorEnv::reset(const int env) {
+    std::uint8_t *const wall = &m_wall[cellIndex(env, 0, 0)];
+    std::uint8_t *const apple = &m_apple[cellIndex(env, 0, 0)];
+    std::fill(wall, wall + m_cellsPerEnv, 1);
+    std::fill(apple, apple + m_cellsPerEnv, 0);
+
+    carveSidewinder(m_dim,
+                    [this, env](const int from, const int to) { return randInt(env, from, to); },
+                    [this, wall](const int row, const int col) { wall[row * m_dim + col] = 0; });
+
+    // aceleasi limite ca in Game::placeApples; merele stau doar sub randul 0
+    const int freeCells = (int) std::count(wall + m_dim, wall + m_cellsPerEnv, 0);
+    int lowerLimit = 5;
+    int upperLimit = freeCells / 2;
+    if (upperLimit < lowerLimit) {
+        std::swap(lowerLimit, upperLimit);
+    }
+    const int numberOfApples = std::min(randInt(env, lowerLimit, upperLimit), 60);
+
+    int placed = 0;
+    for (int i = 0; i < numberOfApples && freeCells > 0; i++) {
+        int cell = 0;
+        do { // o celula libera aleasa uniform, prin respingere
+            cell = randInt(env, m_dim, m_cellsPerEnv - 1);
+        } while (wall[cell]);
+
+        if (!apple[cell]) { // ca in Game, o pozitie deja folosita nu mai primeste alt mar
+            apple[cell] = 1;
+            ++placed;
+        }
+    }
+
+    m_row[env] = 0;
+    m_col[env] = 0;
+    m_applesLeft[env] = (std::uint16_t) placed;
+    m_hasBomb[env] = 0;
+    m_bombCol[env] = (std::int16_t) randInt(env, 2, m_dim - 2);
+    m_bombRespawnIn[env] = 0;
+    m_steps[env] = 0;
+    updateWalls(env);
+}
+
+void VectorEnv::updateWalls(const int env) {
+    const int row = m_row[env];
+    const int col = m_col[env];
+    const std::uint8_t *const wall = &m_wall[cellIndex(env, 0, 0)];
+
+    std::uint8_t mask = 0;
+    if (row == 0 || wall[(row - 1) * m_dim + col]) mask |= wallUp;
+    if (col == 0 || wall[row * m_dim + col - 1]) mask |= wallLeft;
+    if (row == m_dim - 1 || wall[(row + 1) * m_dim + col]) mask |= wallDown;
+    if (col == m_dim - 1 || wall[row * m_dim + col + 1]) mask |= wallRight;
+    m_walls[env] = mask;
+}
+
+void VectorEnv::stepOne(const int env, const std::uint8_t action) {
+    std::uint8_t *const wall = &m_wall[cellIndex(env, 0, 0)];
+    const int row = m_row[env];
+    const int col = m_col[env];
+    float reward = 0.0f;
+
+    switch (action) {
+        case Up:
+            if (!(m_walls[env] & wallUp)) m_row[env] = (std::int16_t) (row - 1);
+            break;
+        case Left:
+            if (!(m_walls[env] & wallLeft)) m_col[env] = (std::int16_t) (col - 1);
+            break;
+        case Down:
+            if (!(m_walls[env] & wallDown)) m_row[env] = (std::int16_t) (row + 1);
+            break;
+        case Right:
+            if (!(m_walls[env] & wallRight)) m_col[env] = (std::int16_t) (col + 1);
+            break;
+        case PickUp: {
+            std::uint8_t &apple = m_apple[cellIndex(env, row, col)];
+            if (apple) {
+                apple = 0;
+                --m_applesLeft[env];
+                reward += appleReward;
+            }
+            if (row == 0 && col == m_bombCol[env]) { // bomba se ia de pe randul 0
+                m_hasBomb[env] = 1;
+                m_bombCol[env] = -1;
+                m_bombRespawnIn[env] = m_bombRespawnSteps;
+            }
+            break;
+        }
+        case Bomb:
+            if (m_hasBomb[env]) { // ca Maze::createHole: cei 8 vecini devin liberi
+                for (int r = std::max(row - 1, 0); r <= std::min(row + 1, m_dim - 1); r++) {
+                    for (int c = std::max(col - 1, 0); c <= std::min(col + 1, m_dim - 1); c++) {
+                        wall[r * m_dim + c] = 0;
+                    }
+                }
+                m_hasBomb[env] = 0;
+            }
+            break;
+        default:
+            break;
+    }
+
+    if (m_bombCol[env] < 0 && --m_bombRespawnIn[env] <= 0) {
+        m_bombCol[env] = (std::int16_t) randInt(env, 2, m_dim - 2);
+    }
+
+    const bool won = m_applesLeft[env] == 0 && m_row[env] == 0 && m_col[env] == 0;
+    if (won) {
+        reward += exitReward;
+    }
+
+    m_reward[env] = reward;
+    m_done[env] = won || ++m_steps[env] >= m_maxSteps;
+
+    if (m_done[env]) {
+        reset(env);
+    }
+    else {
+        updateWalls(env);
+    }
+}
+
+void VectorEnv::stepRange(const std::span<const std::uint8_t> actions, const int begin, const int end) {
+    for (int env = begin; env < end; env++) {
+        stepOne(env, actions[env]);
+    }
+}
+
+VectorEnv::StepResult VectorEnv::step(const std::span<const std::uint8_t> actions) {
+    if ((int) actions.size() != m_numEnvs) {
+        throw std::invalid_argument("VectorEnv::step expects one action per environment");
+    }
+
+    // instantele sunt independente, deci intervale disjuncte pot fi avansate pe thread-uri diferite
+    ThreadPool::shared().parallelFor(0, m_numEnvs, envsPerTask, [this, actions](const std::int64_t begin, const std::int64_t end) {
+        stepRange(actions, (int) begin, (int) end);
+    });
+
+    return StepResult{observations(), m_reward, m_done};
+}
+
+VectorEnv::Observations VectorEnv::observations() const {
+    return Observations{m_row, m_col, m_applesLeft, m_hasBomb, m_bombCol, m_walls};
+}
+
+int VectorEnv::size() const {
+    return m_numEnvs;
+}
+
+int VectorEnv::getMazeSize() const {
+    return m_dim;
+}
+
+bool VectorEnv::isWall(const int env, const int row, const int col) const {
+    return m_wall[cellIndex(env, row, col)] != 0;
+}
+
+bool VectorEnv::hasApple(const int env, const int row, const int col) const {
+    return m_apple[cellIndex(env, row, col)] != 0;
+}
@@ -0,0 +1,28 @@
+#include "Zobrist.h"
+
+std::uint64_t Zobrist::hash(const SyncState &state) {
+    std::uint64_t hash = 0;
+    for (int row = 0; row < state.dim; row++) {
+        for (int col = 0; col < state.dim; col++) {
+            const std::size_t index = (std::size_t) row * state.dim + col;
+            if (state.wall[index]) {
+                hash ^= cell(Feature::Wall, state.dim, row, col);
+            }
+            if (state.apple[index]) {
+                hash ^= cell(Feature::Apple, state.dim, row, col);
+            }
+        }
+    }
+
+    if (state.bombCol >= 0) {
+        hash ^= bomb(state.bombCol);
+    }
+
+    for (int i = 0; i < (int) state.players.size(); i++) {
+        hash ^= player(i, state.dim, state.players[i].row, state.players[i].col);
+        if (state.players[i].hasBomb) {
+            hash ^= hasBomb(i);
+        }
+    }
+    return hash;
+}